@@ -34,7 +34,18 @@ SUCH DAMAGE.
 #include <_ansi.h>
 #include <sys/lock.h>
 
-#define ENV_LOCK __LIBC_LOCK()
-#define ENV_UNLOCK __LIBC_UNLOCK()
+#define ENV_LOCK __ENV_LOCK()
+#define ENV_UNLOCK __ENV_UNLOCK()
+
+/* Used around changes to environ so getenv knows its index is stale */
+#ifdef __PICOLIBC_GETENV_HASH
+void __env_modify_begin (void);
+void __env_modify_end (void);
+#define ENV_MODIFY_LOCK do { ENV_LOCK; __env_modify_begin (); } while (0)
+#define ENV_MODIFY_UNLOCK do { __env_modify_end (); ENV_UNLOCK; } while (0)
+#else
+#define ENV_MODIFY_LOCK ENV_LOCK
+#define ENV_MODIFY_UNLOCK ENV_UNLOCK
+#endif
 
 #endif /* _INCLUDE_ENVLOCK_H_ */
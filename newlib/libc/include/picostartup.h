@@ -0,0 +1,92 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _PICOSTARTUP_H_
+#define _PICOSTARTUP_H_
+
+#include <stdint.h>
+
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+
+/*
+ * Startup timing, enabled with -Dcrt-startup-timing=true. picocrt and
+ * __libc_init_array record a timestamp as each startup phase begins:
+ * "data", "bss", "tls", one "preinit"/"init" entry per constructor
+ * (with its address), "cmdline" and finally "main". The table is
+ * printed at exit, or after main returns for crt0 variants which
+ * don't call exit; applications may call __startup_dump earlier.
+ */
+
+#ifndef __STARTUP_TIMING_MAX
+#define __STARTUP_TIMING_MAX	32
+#endif
+
+struct __startup_time {
+	const char	*phase;
+	void		(*func)(void);
+	uint64_t	time;
+};
+
+extern struct __startup_time __startup_times[__STARTUP_TIMING_MAX];
+extern unsigned __startup_count;
+
+/*
+ * Read the cycle counter. The default reads the TSC on x86, the
+ * virtual counter on AArch64 and the cycle CSR on RISC-V, and returns
+ * zero elsewhere; applications can supply their own. It is called
+ * before .data and .bss are initialized, so it must not depend on
+ * either of them.
+ */
+uint64_t
+__startup_timer(void);
+
+/* Record the start of a phase at the given time */
+void
+__startup_record(const char *phase, void (*func)(void), uint64_t time);
+
+/* Record the start of a phase now */
+static inline void
+__startup_mark(const char *phase, void (*func)(void))
+{
+	__startup_record(phase, func, __startup_timer());
+}
+
+/* Print the time spent in each phase */
+void
+__startup_dump(void);
+
+#endif /* __PICOLIBC_CRT_STARTUP_TIMING */
+
+#endif /* _PICOSTARTUP_H_ */
@@ -41,9 +41,16 @@
 #include <sys/types.h>
 
 extern char __tls_size[];
+extern char __tls_align[];
 
+/*
+ * Size and alignment of a TLS block. A thread system allocates one
+ * block of this size and alignment per thread.
+ */
 static inline size_t _tls_size(void) { return (size_t) (uintptr_t) __tls_size; }
 
+static inline size_t _tls_align(void) { return (size_t) (uintptr_t) __tls_align; }
+
 /*
  * Initialize a TLS block, copying the data segment from flash and
  * zeroing the BSS segment.
@@ -51,9 +58,29 @@ static inline size_t _tls_size(void) { return (size_t) (uintptr_t) __tls_size; }
 void
 _init_tls(void *tls);
 
+/*
+ * The two halves of _init_tls. Blocks carved from memory which is
+ * already zero (calloc, a freshly cleared stack area) only need
+ * _init_tls_data; thread systems may also defer _init_tls_bss until
+ * just before the thread first runs.
+ */
+void
+_init_tls_data(void *tls);
+
+void
+_init_tls_bss(void *tls);
+
 /* Set the TLS pointer to the specific block */
 void
 _set_tls(void *tls);
+
+/* Initialize a TLS block and make it the current one */
+static inline void
+_setup_tls(void *tls)
+{
+	_init_tls(tls);
+	_set_tls(tls);
+}
 #endif
 
 #endif /* _PICOTLS_H_ */
@@ -6,6 +6,7 @@
 
 #include <newlib.h>
 #include <_ansi.h>
+#include <machine/_default_types.h>
 
 #if !defined(_RETARGETABLE_LOCKING)
 
@@ -39,33 +40,163 @@ typedef struct __lock * _LOCK_T;
 #define __LOCK_INIT_RECURSIVE(lock) __LOCK_INIT(lock)
 
 extern void __retarget_lock_init(_LOCK_T *lock);
-#define __lock_init(lock) __retarget_lock_init(&lock)
 extern void __retarget_lock_init_recursive(_LOCK_T *lock);
-#define __lock_init_recursive(lock) __retarget_lock_init_recursive(&lock)
 extern void __retarget_lock_close(_LOCK_T lock);
-#define __lock_close(lock) __retarget_lock_close(lock)
 extern void __retarget_lock_close_recursive(_LOCK_T lock);
-#define __lock_close_recursive(lock) __retarget_lock_close_recursive(lock)
 extern void __retarget_lock_acquire(_LOCK_T lock);
-#define __lock_acquire(lock) __retarget_lock_acquire(lock)
 extern void __retarget_lock_acquire_recursive(_LOCK_T lock);
-#define __lock_acquire_recursive(lock) __retarget_lock_acquire_recursive(lock)
 extern int __retarget_lock_try_acquire(_LOCK_T lock);
-#define __lock_try_acquire(lock) __retarget_lock_try_acquire(lock)
 extern int __retarget_lock_try_acquire_recursive(_LOCK_T lock);
+extern void __retarget_lock_release(_LOCK_T lock);
+extern void __retarget_lock_release_recursive(_LOCK_T lock);
+
+#ifdef __PICOLIBC_LOCK_STATS
+
+/*
+ * Lock statistics, enabled with -Dlock-stats=true. Every lock
+ * operation in libc goes through these wrappers, which count
+ * acquisitions, count the ones where a first try_acquire failed
+ * (contended) and measure how long each lock was held. Statistics
+ * are kept for each named static lock below and for each dynamic
+ * (FILE) lock. __lock_stats_dump prints them.
+ */
+
+extern void __lock_stats_init(_LOCK_T *lock);
+extern void __lock_stats_init_recursive(_LOCK_T *lock);
+extern void __lock_stats_close(_LOCK_T lock);
+extern void __lock_stats_close_recursive(_LOCK_T lock);
+extern void __lock_stats_acquire(_LOCK_T lock);
+extern void __lock_stats_acquire_recursive(_LOCK_T lock);
+extern int __lock_stats_try_acquire(_LOCK_T lock);
+extern int __lock_stats_try_acquire_recursive(_LOCK_T lock);
+extern void __lock_stats_release(_LOCK_T lock);
+extern void __lock_stats_release_recursive(_LOCK_T lock);
+
+/* Time source for hold times, defaults to the CPU cycle counter */
+extern __uint64_t __lock_stats_timer(void);
+
+/* Print the statistics */
+extern void __lock_stats_dump(void);
+
+/* Clear the statistics */
+extern void __lock_stats_reset(void);
+
+/* Fetch the counts for one lock, returns 0 if it isn't tracked */
+extern int __lock_stats_count(_LOCK_T lock, unsigned long *acquired,
+                              unsigned long *contended);
+
+#define __lock_init(lock) __lock_stats_init(&lock)
+#define __lock_init_recursive(lock) __lock_stats_init_recursive(&lock)
+#define __lock_close(lock) __lock_stats_close(lock)
+#define __lock_close_recursive(lock) __lock_stats_close_recursive(lock)
+#define __lock_acquire(lock) __lock_stats_acquire(lock)
+#define __lock_acquire_recursive(lock) __lock_stats_acquire_recursive(lock)
+#define __lock_try_acquire(lock) __lock_stats_try_acquire(lock)
+#define __lock_try_acquire_recursive(lock) \
+  __lock_stats_try_acquire_recursive(lock)
+#define __lock_release(lock) __lock_stats_release(lock)
+#define __lock_release_recursive(lock) __lock_stats_release_recursive(lock)
+
+#else
+
+#define __lock_init(lock) __retarget_lock_init(&lock)
+#define __lock_init_recursive(lock) __retarget_lock_init_recursive(&lock)
+#define __lock_close(lock) __retarget_lock_close(lock)
+#define __lock_close_recursive(lock) __retarget_lock_close_recursive(lock)
+#define __lock_acquire(lock) __retarget_lock_acquire(lock)
+#define __lock_acquire_recursive(lock) __retarget_lock_acquire_recursive(lock)
+#define __lock_try_acquire(lock) __retarget_lock_try_acquire(lock)
 #define __lock_try_acquire_recursive(lock) \
   __retarget_lock_try_acquire_recursive(lock)
-extern void __retarget_lock_release(_LOCK_T lock);
 #define __lock_release(lock) __retarget_lock_release(lock)
-extern void __retarget_lock_release_recursive(_LOCK_T lock);
 #define __lock_release_recursive(lock) __retarget_lock_release_recursive(lock)
 
+#endif /* __PICOLIBC_LOCK_STATS */
+
 #ifdef __cplusplus
 }
 #endif
 
 #endif /* !defined(_RETARGETABLE_LOCKING) */
 
+#ifdef __PICOLIBC_SUBSYSTEM_LOCKS
+
+/*
+ * Static locks, one per subsystem so that, for example, a thread
+ * busy in malloc doesn't hold up another one calling getenv. A thread
+ * holding one of these locks may only acquire locks which appear
+ * later in this list:
+ *
+ *	__atexit_recursive_mutex	atexit/on_exit handlers (legacy
+ *					exit runs handlers holding it)
+ *	__at_quick_exit_mutex		at_quick_exit handlers
+ *	__sfp_recursive_mutex		legacy stdio stream list
+ *	__locale_mutex			global locale (setlocale)
+ *	__tz_mutex			timezone rules
+ *	__env_recursive_mutex		environment
+ *	__arc4random_mutex		arc4random state
+ *	__malloc_recursive_mutex	malloc heap
+ *	__libc_recursive_mutex		anything else
+ */
+
+#define __ATEXIT_LOCK()		__lock_acquire_recursive(&__lock___atexit_recursive_mutex)
+#define __ATEXIT_UNLOCK()	__lock_release_recursive(&__lock___atexit_recursive_mutex)
+__LOCK_INIT_RECURSIVE(__atexit_recursive_mutex)
+
+#define __AT_QUICK_EXIT_LOCK()	__lock_acquire(&__lock___at_quick_exit_mutex)
+#define __AT_QUICK_EXIT_UNLOCK() __lock_release(&__lock___at_quick_exit_mutex)
+__LOCK_INIT(__at_quick_exit_mutex)
+
+#define __SFP_LOCK()		__lock_acquire_recursive(&__lock___sfp_recursive_mutex)
+#define __SFP_UNLOCK()		__lock_release_recursive(&__lock___sfp_recursive_mutex)
+__LOCK_INIT_RECURSIVE(__sfp_recursive_mutex)
+
+#define __LOCALE_LOCK()		__lock_acquire(&__lock___locale_mutex)
+#define __LOCALE_UNLOCK()	__lock_release(&__lock___locale_mutex)
+__LOCK_INIT(__locale_mutex)
+
+#define __TZ_LOCK()		__lock_acquire(&__lock___tz_mutex)
+#define __TZ_UNLOCK()		__lock_release(&__lock___tz_mutex)
+__LOCK_INIT(__tz_mutex)
+
+#define __ENV_LOCK()		__lock_acquire_recursive(&__lock___env_recursive_mutex)
+#define __ENV_UNLOCK()		__lock_release_recursive(&__lock___env_recursive_mutex)
+__LOCK_INIT_RECURSIVE(__env_recursive_mutex)
+
+#define __ARC4RANDOM_LOCK()	__lock_acquire(&__lock___arc4random_mutex)
+#define __ARC4RANDOM_UNLOCK()	__lock_release(&__lock___arc4random_mutex)
+__LOCK_INIT(__arc4random_mutex)
+
+#define __MALLOC_LOCK()		__lock_acquire_recursive(&__lock___malloc_recursive_mutex)
+#define __MALLOC_UNLOCK()	__lock_release_recursive(&__lock___malloc_recursive_mutex)
+__LOCK_INIT_RECURSIVE(__malloc_recursive_mutex)
+
+#else /* __PICOLIBC_SUBSYSTEM_LOCKS */
+
+/*
+ * Without subsystem-locks, everything shares __libc_recursive_mutex,
+ * so lock implementations need only define that one.
+ */
+
+#define __ATEXIT_LOCK()		__LIBC_LOCK()
+#define __ATEXIT_UNLOCK()	__LIBC_UNLOCK()
+#define __AT_QUICK_EXIT_LOCK()	__LIBC_LOCK()
+#define __AT_QUICK_EXIT_UNLOCK() __LIBC_UNLOCK()
+#define __SFP_LOCK()		__LIBC_LOCK()
+#define __SFP_UNLOCK()		__LIBC_UNLOCK()
+#define __LOCALE_LOCK()		__LIBC_LOCK()
+#define __LOCALE_UNLOCK()	__LIBC_UNLOCK()
+#define __TZ_LOCK()		__LIBC_LOCK()
+#define __TZ_UNLOCK()		__LIBC_UNLOCK()
+#define __ENV_LOCK()		__LIBC_LOCK()
+#define __ENV_UNLOCK()		__LIBC_UNLOCK()
+#define __ARC4RANDOM_LOCK()	__LIBC_LOCK()
+#define __ARC4RANDOM_UNLOCK()	__LIBC_UNLOCK()
+#define __MALLOC_LOCK()		__LIBC_LOCK()
+#define __MALLOC_UNLOCK()	__LIBC_UNLOCK()
+
+#endif /* __PICOLIBC_SUBSYSTEM_LOCKS */
+
 #define __LIBC_LOCK()	__lock_acquire_recursive(&__lock___libc_recursive_mutex)
 #define __LIBC_UNLOCK()	__lock_release_recursive(&__lock___libc_recursive_mutex)
 __LOCK_INIT_RECURSIVE(__libc_recursive_mutex)
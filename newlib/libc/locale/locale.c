@@ -150,6 +150,7 @@ No supporting OS subroutines are required.
 #include <limits.h>
 #include <stdlib.h>
 #include <wchar.h>
+#include <sys/lock.h>
 #include "setlocale.h"
 #include "../ctype/ctype_.h"
 #include "../stdlib/local.h"
@@ -281,21 +282,10 @@ static char *currentlocale (void);
 
 #endif /* _MB_CAPABLE */
 
-char *
-setlocale (
-       int category,
-       const char *locale)
+#ifdef _MB_CAPABLE
+static char *
+_setlocale_unlocked (int category, const char *locale)
 {
-  (void) category;
-#ifndef _MB_CAPABLE
-  if (locale)
-    { 
-      if (strcmp (locale, "POSIX") && strcmp (locale, "C")
-	  && strcmp (locale, ""))
-        return NULL;
-    }
-  return "C";
-#else /* _MB_CAPABLE */
   static char new_categories[_LC_LAST][ENCODING_LEN + 1];
   static char saved_categories[_LC_LAST][ENCODING_LEN + 1];
   int i, j, len, saverr;
@@ -427,6 +417,30 @@ setlocale (
 	}
     }
   return currentlocale ();
+}
+#endif /* _MB_CAPABLE */
+
+char *
+setlocale (
+       int category,
+       const char *locale)
+{
+  (void) category;
+#ifndef _MB_CAPABLE
+  if (locale)
+    { 
+      if (strcmp (locale, "POSIX") && strcmp (locale, "C")
+	  && strcmp (locale, ""))
+        return NULL;
+    }
+  return "C";
+#else /* _MB_CAPABLE */
+  char *ret;
+
+  __LOCALE_LOCK();
+  ret = _setlocale_unlocked (category, locale);
+  __LOCALE_UNLOCK();
+  return ret;
 #endif /* _MB_CAPABLE */
 }
 
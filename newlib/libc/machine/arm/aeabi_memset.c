@@ -47,6 +47,14 @@ void __aeabi_memset8 (void *dest, size_t n, int c)
 
 #undef memset
 
+/* The MVE memset uses vector registers, which __aeabi_memset must
+   preserve, so call the scalar version from memset.S instead.  */
+#if defined (__ARM_FEATURE_MVE) && !defined (__SOFTFP__) \
+    && !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+void *__memset_scalar (void *dest, int c, size_t n);
+#define memset __memset_scalar
+#endif
+
 void __attribute__((used)) __aeabi_memset (void *dest, size_t n, int c)
 {
   /*Note that relative to ANSI memset, __aeabi_memset hase the order
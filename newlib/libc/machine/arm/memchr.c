@@ -29,7 +29,9 @@
 
 #include "acle-compat.h"
 
-#if defined (__ARM_NEON__) || defined (__ARM_NEON)
+#if defined (__ARM_FEATURE_MVE) && !defined (__OPTIMIZE_SIZE__) && !defined (PREFER_SIZE_OVER_SPEED)
+/* Defined in memchr.S.  */
+#elif defined (__ARM_NEON__) || defined (__ARM_NEON)
 /* Defined in memchr.S.  */
 #elif __ARM_ARCH_ISA_THUMB >= 2 && defined (__ARM_FEATURE_DSP)
 /* Defined in memchr.S.  */
@@ -31,6 +31,8 @@
 
 #if (defined (__OPTIMIZE_SIZE__) || defined (PREFER_SIZE_OVER_SPEED))
 #define MEMCPY_FALLBACK
+#elif defined (__ARM_FEATURE_MVE)
+/* Defined in memcpy.S.  */
 #elif (__ARM_ARCH >= 7 && __ARM_ARCH_PROFILE == 'A' \
        && defined (__ARM_FEATURE_UNALIGNED))
 /* Defined in memcpy.S.  */
@@ -47,6 +47,9 @@
 #if defined __thumb__ && ! defined __thumb2__
 #include "../../string/strlen.c"
 
+#elif defined (__ARM_FEATURE_MVE)
+  /* Implemented in strlen.S.  */
+
 #elif __ARM_ARCH_ISA_THUMB >= 2 && defined __ARM_FEATURE_DSP
   /* Implemented in strlen.S.  */
 
@@ -9,7 +9,7 @@
    http://www.opensource.org/licenses.
 */
 
-#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
+#if defined(__riscv_vector) || defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
 //memcpy defined in memcpy-asm.S
 #else
 
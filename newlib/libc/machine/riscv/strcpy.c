@@ -9,6 +9,9 @@
    http://www.opensource.org/licenses.
 */
 
+/* The vector version is in strcpy-asm.S */
+#ifndef __riscv_vector
+
 #include <string.h>
 #include <stdint.h>
 
@@ -64,3 +67,5 @@ out:
 
   return dst0;
 }
+
+#endif /* __riscv_vector */
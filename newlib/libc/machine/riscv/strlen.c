@@ -9,6 +9,9 @@
    http://www.opensource.org/licenses.
 */
 
+/* The vector version is in strlen-asm.S */
+#ifndef __riscv_vector
+
 #include <string.h>
 #include <stdint.h>
 
@@ -51,3 +54,5 @@ size_t strlen(const char *str)
   return ret + 7 - sl;
 #endif /* not PREFER_SIZE_OVER_SPEED */
 }
+
+#endif /* __riscv_vector */
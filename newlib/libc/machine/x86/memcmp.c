@@ -1,3 +0,0 @@
-#ifdef __x86_64
-#include "../../string/memcmp.c"
-#endif
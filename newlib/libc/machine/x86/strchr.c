@@ -1,3 +0,0 @@
-#ifdef __x86_64
-#include "../../string/strchr.c"
-#endif
@@ -56,6 +56,15 @@ is preserved.
 #define ebp REG(ebp)
 #define esp REG(esp)
 
+#define r8d  REG(r8d)
+#define r9d  REG(r9d)
+#define r10d REG(r10d)
+#define r11d REG(r11d)
+
+#define r8b  REG(r8b)
+#define r9b  REG(r9b)
+#define r10b REG(r10b)
+
 #define st0 REG(st)
 #define st1 REG(st(1))
 #define st2 REG(st(2))
@@ -98,6 +107,17 @@ is preserved.
 #define xmm5 REG(xmm5)
 #define xmm6 REG(xmm6)
 #define xmm7 REG(xmm7)
+#define xmm8 REG(xmm8)
+
+#define ymm0 REG(ymm0)
+#define ymm1 REG(ymm1)
+#define ymm2 REG(ymm2)
+#define ymm3 REG(ymm3)
+#define ymm4 REG(ymm4)
+#define ymm5 REG(ymm5)
+#define ymm6 REG(ymm6)
+#define ymm7 REG(ymm7)
+#define ymm8 REG(ymm8)
 
 #define cr0 REG(cr0)
 #define cr1 REG(cr1)
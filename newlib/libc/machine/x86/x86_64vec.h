@@ -0,0 +1,135 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Vector helpers shared by the x86_64 string functions. SSE2 is part
+ * of the x86_64 baseline and is used by default; building with an
+ * -march that enables AVX2 switches to 32-byte vectors.
+ *
+ * All of the loads done through these macros are either aligned to
+ * VEC_SIZE, which means they never cross a page boundary, or fall
+ * entirely within the caller's buffer.
+ */
+
+#include "x86_64mach.h"
+
+/*
+ * Size thresholds for memcpy, memmove and memset. Operations of at
+ * least X86_REP_THRESHOLD bytes use 'rep movsb'/'rep stosb', which is
+ * fastest on CPUs with enhanced rep movsb (ERMS). Operations of at
+ * least X86_NT_THRESHOLD bytes, which should be around the size of the
+ * last-level cache, use non-temporal stores to avoid evicting the rest
+ * of the cache. Both can be overridden at build time with -D.
+ */
+#ifndef X86_REP_THRESHOLD
+#define X86_REP_THRESHOLD	2048
+#endif
+
+#ifndef X86_NT_THRESHOLD
+#define X86_NT_THRESHOLD	0x400000
+#endif
+
+#ifdef __AVX2__
+
+#define VEC_SIZE	32
+#define VEC_MASK	0xffffffff
+
+#define V0	ymm0
+#define V1	ymm1
+#define V2	ymm2
+#define V3	ymm3
+#define V4	ymm4
+#define V5	ymm5
+#define V6	ymm6
+#define V7	ymm7
+#define V8	ymm8
+
+#define VLOADA(m, v)	vmovdqa m, v
+#define VLOADU(m, v)	vmovdqu m, v
+#define VSTOREA(v, m)	vmovdqa v, m
+#define VSTOREU(v, m)	vmovdqu v, m
+#define VSTORENT(v, m)	vmovntdq v, m
+#define VMOV(a, v)	vmovdqa a, v
+#define VZERO(v)	vpxor v, v, v
+#define VCMPEQ(a, v)	vpcmpeqb a, v, v
+#define VCMPEQD(a, v)	vpcmpeqd a, v, v
+#define VOR(a, v)	vpor a, v, v
+#define VXOR(a, v)	vpxor a, v, v
+#define VMOVMSK(v, r)	vpmovmskb v, r
+
+/* Replicate the low byte of esi across all of V0 */
+#define VBROADCAST_SIL	vmovd esi, xmm0; vpbroadcastb xmm0, ymm0
+
+/* Replicate esi across the 32-bit lanes of V0 */
+#define VBROADCAST_ESI	vmovd esi, xmm0; vpbroadcastd xmm0, ymm0
+
+#define VZEROUPPER	vzeroupper
+
+#else
+
+#define VEC_SIZE	16
+#define VEC_MASK	0xffff
+
+#define V0	xmm0
+#define V1	xmm1
+#define V2	xmm2
+#define V3	xmm3
+#define V4	xmm4
+#define V5	xmm5
+#define V6	xmm6
+#define V7	xmm7
+#define V8	xmm8
+
+#define VLOADA(m, v)	movdqa m, v
+#define VLOADU(m, v)	movdqu m, v
+#define VSTOREA(v, m)	movdqa v, m
+#define VSTOREU(v, m)	movdqu v, m
+#define VSTORENT(v, m)	movntdq v, m
+#define VMOV(a, v)	movdqa a, v
+#define VZERO(v)	pxor v, v
+#define VCMPEQ(a, v)	pcmpeqb a, v
+#define VCMPEQD(a, v)	pcmpeqd a, v
+#define VOR(a, v)	por a, v
+#define VXOR(a, v)	pxor a, v
+#define VMOVMSK(v, r)	pmovmskb v, r
+
+#define VBROADCAST_SIL	movd esi, xmm0; punpcklbw xmm0, xmm0; \
+			punpcklwd xmm0, xmm0; pshufd $0, xmm0, xmm0
+
+#define VBROADCAST_ESI	movd esi, xmm0; pshufd $0, xmm0, xmm0
+
+#define VZEROUPPER
+
+#endif
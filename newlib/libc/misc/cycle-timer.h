@@ -0,0 +1,73 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Cycle counter shared by the startup timing and lock statistics
+ * code: the TSC on x86, the virtual counter on AArch64 and the cycle
+ * CSR on RISC-V. Other targets get zero, and the callers provide
+ * weak hooks so applications can substitute their own timer.
+ */
+
+#ifndef _CYCLE_TIMER_H_
+#define _CYCLE_TIMER_H_
+
+#include <stdint.h>
+
+static inline uint64_t
+__cycle_timer(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+	uint64_t t;
+	__asm__ volatile("isb; mrs %0, cntvct_el0" : "=r" (t));
+	return t;
+#elif defined(__riscv) && __riscv_xlen == 32
+	uint32_t hi, lo, hi2;
+	do {
+		__asm__ volatile("rdcycleh %0; rdcycle %1; rdcycleh %2"
+				 : "=r" (hi), "=r" (lo), "=r" (hi2));
+	} while (hi != hi2);
+	return ((uint64_t) hi << 32) | lo;
+#elif defined(__riscv)
+	uint64_t t;
+	__asm__ volatile("rdcycle %0" : "=r" (t));
+	return t;
+#else
+	return 0;
+#endif
+}
+
+#endif /* _CYCLE_TIMER_H_ */
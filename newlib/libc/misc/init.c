@@ -12,6 +12,13 @@
 
 /* Handle ELF .{pre_init,init,fini}_array sections.  */
 #include <sys/types.h>
+#include <picostartup.h>
+
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+#define MARK(phase, func)  __startup_mark(phase, func)
+#else
+#define MARK(phase, func)
+#endif
 
 #ifdef _HAVE_INITFINI_ARRAY
 
@@ -33,16 +40,22 @@ __libc_init_array (void)
   size_t i;
 
   count = __preinit_array_end - __preinit_array_start;
-  for (i = 0; i < count; i++)
+  for (i = 0; i < count; i++) {
+    MARK ("preinit", __preinit_array_start[i]);
     __preinit_array_start[i] ();
+  }
 
 #ifdef _HAVE_INIT_FINI
-  if (_init)
+  if (_init) {
+    MARK ("_init", _init);
     _init ();
+  }
 #endif
 
   count = __init_array_end - __init_array_start;
-  for (i = 0; i < count; i++)
+  for (i = 0; i < count; i++) {
+    MARK ("init", __init_array_start[i]);
     __init_array_start[i] ();
+  }
 }
 #endif
@@ -0,0 +1,256 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Retargetable locks for hosted Linux builds, enabled with
+ * -Dfutex-locking=true. Each lock is a three-state futex word
+ * (0 unlocked, 1 locked, 2 locked with waiters) plus an owner and a
+ * count so that the recursive entry points can nest. Acquiring spins
+ * briefly while the holder runs before sleeping in the kernel, and
+ * releasing only makes a system call when some thread is asleep.
+ */
+
+#include <sys/lock.h>
+
+#if !defined(__SINGLE_THREAD__) && defined(__PICOLIBC_FUTEX_LOCKING)
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <asm/unistd.h>
+#include <linux/futex.h>
+
+/* From the host C library */
+extern long syscall(long number, ...);
+
+#ifndef LOCK_SPIN
+#define LOCK_SPIN       100
+#endif
+
+struct __lock {
+	atomic_int	futex;
+	atomic_long	owner;
+	unsigned long	count;
+};
+
+#ifdef __PICOLIBC_SUBSYSTEM_LOCKS
+struct __lock __lock___atexit_recursive_mutex;
+struct __lock __lock___at_quick_exit_mutex;
+struct __lock __lock___sfp_recursive_mutex;
+struct __lock __lock___locale_mutex;
+struct __lock __lock___tz_mutex;
+struct __lock __lock___env_recursive_mutex;
+struct __lock __lock___arc4random_mutex;
+struct __lock __lock___malloc_recursive_mutex;
+#endif
+struct __lock __lock___libc_recursive_mutex;
+
+/* Used when a dynamic lock can't be allocated. Sharing it is safe
+ * because every lock can be taken recursively */
+static struct __lock __lock_fallback;
+
+static inline void
+lock_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+	__asm__ volatile("yield");
+#endif
+}
+
+static long
+lock_self(void)
+{
+#ifdef PICOLIBC_TLS
+	static NEWLIB_THREAD_LOCAL long self;
+
+	if (!self)
+		self = syscall(__NR_gettid);
+	return self;
+#else
+	return syscall(__NR_gettid);
+#endif
+}
+
+static void
+futex_lock(atomic_int *futex)
+{
+	int c = 0;
+	int spin;
+
+	for (spin = 0; spin < LOCK_SPIN; spin++) {
+		c = 0;
+		if (atomic_compare_exchange_weak_explicit(futex, &c, 1,
+							  memory_order_acquire,
+							  memory_order_relaxed))
+			return;
+		/* Don't spin behind threads already asleep */
+		if (c == 2)
+			break;
+		lock_relax();
+	}
+	if (c != 2)
+		c = atomic_exchange_explicit(futex, 2, memory_order_acquire);
+	while (c != 0) {
+		syscall(__NR_futex, futex, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0);
+		c = atomic_exchange_explicit(futex, 2, memory_order_acquire);
+	}
+}
+
+static void
+futex_unlock(atomic_int *futex)
+{
+	if (atomic_exchange_explicit(futex, 0, memory_order_release) == 2)
+		syscall(__NR_futex, futex, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+static void
+lock_acquire(struct __lock *lock)
+{
+	long self = lock_self();
+
+	if (atomic_load_explicit(&lock->owner, memory_order_relaxed) == self) {
+		lock->count++;
+		return;
+	}
+	futex_lock(&lock->futex);
+	atomic_store_explicit(&lock->owner, self, memory_order_relaxed);
+	lock->count = 1;
+}
+
+static int
+lock_try_acquire(struct __lock *lock)
+{
+	long self = lock_self();
+	int c = 0;
+
+	if (atomic_load_explicit(&lock->owner, memory_order_relaxed) == self) {
+		lock->count++;
+		return 1;
+	}
+	if (!atomic_compare_exchange_strong_explicit(&lock->futex, &c, 1,
+						     memory_order_acquire,
+						     memory_order_relaxed))
+		return 0;
+	atomic_store_explicit(&lock->owner, self, memory_order_relaxed);
+	lock->count = 1;
+	return 1;
+}
+
+static void
+lock_release(struct __lock *lock)
+{
+	if (--lock->count == 0) {
+		atomic_store_explicit(&lock->owner, 0, memory_order_relaxed);
+		futex_unlock(&lock->futex);
+	}
+}
+
+static void
+lock_init(_LOCK_T *lock)
+{
+	*lock = calloc(1, sizeof(struct __lock));
+	if (!*lock)
+		*lock = &__lock_fallback;
+}
+
+static void
+lock_close(_LOCK_T lock)
+{
+	if (lock != &__lock_fallback)
+		free(lock);
+}
+
+void
+__retarget_lock_init (_LOCK_T *lock)
+{
+	lock_init(lock);
+}
+
+void
+__retarget_lock_init_recursive(_LOCK_T *lock)
+{
+	lock_init(lock);
+}
+
+void
+__retarget_lock_close(_LOCK_T lock)
+{
+	lock_close(lock);
+}
+
+void
+__retarget_lock_close_recursive(_LOCK_T lock)
+{
+	lock_close(lock);
+}
+
+void
+__retarget_lock_acquire (_LOCK_T lock)
+{
+	lock_acquire(lock);
+}
+
+void
+__retarget_lock_acquire_recursive (_LOCK_T lock)
+{
+	lock_acquire(lock);
+}
+
+int
+__retarget_lock_try_acquire(_LOCK_T lock)
+{
+	return lock_try_acquire(lock);
+}
+
+int
+__retarget_lock_try_acquire_recursive(_LOCK_T lock)
+{
+	return lock_try_acquire(lock);
+}
+
+void
+__retarget_lock_release (_LOCK_T lock)
+{
+	lock_release(lock);
+}
+
+void
+__retarget_lock_release_recursive (_LOCK_T lock)
+{
+	lock_release(lock);
+}
+
+#endif /* !defined(__SINGLE_THREAD__) && defined(__PICOLIBC_FUTEX_LOCKING) */
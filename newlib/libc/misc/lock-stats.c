@@ -0,0 +1,333 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Lock statistics wrappers for the retargetable locking API, see
+ * sys/lock.h. The counters for a lock are only updated by the thread
+ * holding it, so they need no locking of their own; only claiming and
+ * freeing the slots used for dynamic locks takes the libc lock.
+ */
+
+#include <sys/lock.h>
+
+#if defined(_RETARGETABLE_LOCKING) && defined(__PICOLIBC_LOCK_STATS)
+
+#include <stdio.h>
+#include <string.h>
+#include "cycle-timer.h"
+
+#ifndef __LOCK_STATS_FILES
+#define __LOCK_STATS_FILES	16
+#endif
+
+struct lock_stats {
+	const char	*name;
+	_LOCK_T		lock;
+	unsigned long	acquisitions;
+	unsigned long	contended;
+	uint64_t	hold_total;
+	uint64_t	hold_max;
+	uint64_t	start;
+	unsigned	depth;
+};
+
+#define STATIC_LOCK(_name) { .name = #_name, .lock = &__lock_ ## _name }
+
+static struct lock_stats static_stats[] = {
+#ifdef __PICOLIBC_SUBSYSTEM_LOCKS
+	STATIC_LOCK(__atexit_recursive_mutex),
+	STATIC_LOCK(__at_quick_exit_mutex),
+	STATIC_LOCK(__sfp_recursive_mutex),
+	STATIC_LOCK(__locale_mutex),
+	STATIC_LOCK(__tz_mutex),
+	STATIC_LOCK(__env_recursive_mutex),
+	STATIC_LOCK(__arc4random_mutex),
+	STATIC_LOCK(__malloc_recursive_mutex),
+#endif
+	STATIC_LOCK(__libc_recursive_mutex),
+};
+
+#define NUM_STATIC	(sizeof(static_stats) / sizeof(static_stats[0]))
+
+/* Dynamic locks (FILE locks) while open, and the sum of closed ones */
+static struct lock_stats file_stats[__LOCK_STATS_FILES];
+static struct lock_stats closed_stats = { .name = "FILE (closed)" };
+
+uint64_t __attribute__((weak))
+__lock_stats_timer(void)
+{
+	return __cycle_timer();
+}
+
+static struct lock_stats *
+lock_stats_find(_LOCK_T lock)
+{
+	unsigned i;
+
+	for (i = 0; i < NUM_STATIC; i++)
+		if (static_stats[i].lock == lock)
+			return &static_stats[i];
+	for (i = 0; i < __LOCK_STATS_FILES; i++)
+		if (file_stats[i].lock == lock)
+			return &file_stats[i];
+	return NULL;
+}
+
+static void
+lock_stats_add(struct lock_stats *to, const struct lock_stats *from)
+{
+	to->acquisitions += from->acquisitions;
+	to->contended += from->contended;
+	to->hold_total += from->hold_total;
+	if (from->hold_max > to->hold_max)
+		to->hold_max = from->hold_max;
+}
+
+static void
+lock_stats_open(_LOCK_T lock)
+{
+	unsigned i;
+
+	if (!lock)
+		return;
+	__retarget_lock_acquire_recursive(&__lock___libc_recursive_mutex);
+	for (i = 0; i < __LOCK_STATS_FILES; i++) {
+		if (!file_stats[i].lock) {
+			memset(&file_stats[i], 0, sizeof(file_stats[i]));
+			file_stats[i].name = "FILE";
+			file_stats[i].lock = lock;
+			break;
+		}
+	}
+	__retarget_lock_release_recursive(&__lock___libc_recursive_mutex);
+}
+
+static void
+lock_stats_close(_LOCK_T lock)
+{
+	unsigned i;
+
+	__retarget_lock_acquire_recursive(&__lock___libc_recursive_mutex);
+	for (i = 0; i < __LOCK_STATS_FILES; i++) {
+		if (file_stats[i].lock == lock) {
+			lock_stats_add(&closed_stats, &file_stats[i]);
+			file_stats[i].lock = NULL;
+			break;
+		}
+	}
+	__retarget_lock_release_recursive(&__lock___libc_recursive_mutex);
+}
+
+static void
+lock_stats_acquired(_LOCK_T lock, int contended)
+{
+	struct lock_stats *s = lock_stats_find(lock);
+
+	if (s && s->depth++ == 0) {
+		s->acquisitions++;
+		if (contended)
+			s->contended++;
+		s->start = __lock_stats_timer();
+	}
+}
+
+static void
+lock_stats_releasing(_LOCK_T lock)
+{
+	struct lock_stats *s = lock_stats_find(lock);
+
+	if (s && s->depth && --s->depth == 0) {
+		uint64_t hold = __lock_stats_timer() - s->start;
+		s->hold_total += hold;
+		if (hold > s->hold_max)
+			s->hold_max = hold;
+	}
+}
+
+void
+__lock_stats_init(_LOCK_T *lock)
+{
+	__retarget_lock_init(lock);
+	lock_stats_open(*lock);
+}
+
+void
+__lock_stats_init_recursive(_LOCK_T *lock)
+{
+	__retarget_lock_init_recursive(lock);
+	lock_stats_open(*lock);
+}
+
+void
+__lock_stats_close(_LOCK_T lock)
+{
+	lock_stats_close(lock);
+	__retarget_lock_close(lock);
+}
+
+void
+__lock_stats_close_recursive(_LOCK_T lock)
+{
+	lock_stats_close(lock);
+	__retarget_lock_close_recursive(lock);
+}
+
+void
+__lock_stats_acquire(_LOCK_T lock)
+{
+	int contended = 0;
+
+	if (!__retarget_lock_try_acquire(lock)) {
+		contended = 1;
+		__retarget_lock_acquire(lock);
+	}
+	lock_stats_acquired(lock, contended);
+}
+
+void
+__lock_stats_acquire_recursive(_LOCK_T lock)
+{
+	int contended = 0;
+
+	if (!__retarget_lock_try_acquire_recursive(lock)) {
+		contended = 1;
+		__retarget_lock_acquire_recursive(lock);
+	}
+	lock_stats_acquired(lock, contended);
+}
+
+int
+__lock_stats_try_acquire(_LOCK_T lock)
+{
+	if (!__retarget_lock_try_acquire(lock))
+		return 0;
+	lock_stats_acquired(lock, 0);
+	return 1;
+}
+
+int
+__lock_stats_try_acquire_recursive(_LOCK_T lock)
+{
+	if (!__retarget_lock_try_acquire_recursive(lock))
+		return 0;
+	lock_stats_acquired(lock, 0);
+	return 1;
+}
+
+void
+__lock_stats_release(_LOCK_T lock)
+{
+	lock_stats_releasing(lock);
+	__retarget_lock_release(lock);
+}
+
+void
+__lock_stats_release_recursive(_LOCK_T lock)
+{
+	lock_stats_releasing(lock);
+	__retarget_lock_release_recursive(lock);
+}
+
+static void
+lock_stats_print(const struct lock_stats *s, int show_lock)
+{
+	/* Printed as unsigned long so that the integer-only printf
+	 * variants can show them */
+	printf("  %-26s %10lu %10lu %12lu %10lu",
+	       s->name, s->acquisitions, s->contended,
+	       (unsigned long) s->hold_total, (unsigned long) s->hold_max);
+	if (show_lock)
+		printf(" %p", (void *) s->lock);
+	printf("\n");
+}
+
+void
+__lock_stats_dump(void)
+{
+	struct lock_stats s;
+	unsigned i;
+
+	printf("lock statistics (cycles):\n");
+	printf("  %-26s %10s %10s %12s %10s\n",
+	       "lock", "acquired", "contended", "hold total", "hold max");
+	/* Print copies, as printf may take some of these locks */
+	for (i = 0; i < NUM_STATIC; i++) {
+		s = static_stats[i];
+		lock_stats_print(&s, 0);
+	}
+	for (i = 0; i < __LOCK_STATS_FILES; i++) {
+		s = file_stats[i];
+		if (s.lock)
+			lock_stats_print(&s, 1);
+	}
+	s = closed_stats;
+	if (s.acquisitions)
+		lock_stats_print(&s, 0);
+}
+
+static void
+lock_stats_clear(struct lock_stats *s)
+{
+	s->acquisitions = 0;
+	s->contended = 0;
+	s->hold_total = 0;
+	s->hold_max = 0;
+}
+
+int
+__lock_stats_count(_LOCK_T lock, unsigned long *acquired, unsigned long *contended)
+{
+	struct lock_stats *s = lock_stats_find(lock);
+
+	if (!s)
+		return 0;
+	*acquired = s->acquisitions;
+	*contended = s->contended;
+	return 1;
+}
+
+void
+__lock_stats_reset(void)
+{
+	unsigned i;
+
+	for (i = 0; i < NUM_STATIC; i++)
+		lock_stats_clear(&static_stats[i]);
+	for (i = 0; i < __LOCK_STATS_FILES; i++)
+		lock_stats_clear(&file_stats[i]);
+	lock_stats_clear(&closed_stats);
+}
+
+#endif /* defined(_RETARGETABLE_LOCKING) && defined(__PICOLIBC_LOCK_STATS) */
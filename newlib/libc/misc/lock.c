@@ -41,13 +41,15 @@ INDEX
 
 SYNOPSIS
 	#include <lock.h>
-	struct __lock __lock___sfp_recursive_mutex;
 	struct __lock __lock___atexit_recursive_mutex;
 	struct __lock __lock___at_quick_exit_mutex;
-	struct __lock __lock___malloc_recursive_mutex;
-	struct __lock __lock___env_recursive_mutex;
+	struct __lock __lock___sfp_recursive_mutex;
+	struct __lock __lock___locale_mutex;
 	struct __lock __lock___tz_mutex;
+	struct __lock __lock___env_recursive_mutex;
 	struct __lock __lock___arc4random_mutex;
+	struct __lock __lock___malloc_recursive_mutex;
+	struct __lock __lock___libc_recursive_mutex;
 
 	void __retarget_lock_init (_LOCK_T * <[lock_ptr]>);
 	void __retarget_lock_init_recursive (_LOCK_T * <[lock_ptr]>);
@@ -70,7 +72,8 @@ systems.
 For multi-threaded applications the target platform is required to provide
 an implementation for @strong{all} these routines and static locks.  If some
 routines or static locks are missing, the link will fail with doubly defined
-symbols.
+symbols.  The static locks other than __lock___libc_recursive_mutex are only
+used when picolibc is built with the subsystem-locks option.
 
 PORTABILITY
 These locking routines and static lock are newlib-specific.  Supporting OS
@@ -79,7 +82,10 @@ subroutines are required for linking multi-threaded applications.
 
 /* dummy lock routines and static locks for single-threaded apps */
 
-#ifndef __SINGLE_THREAD__
+#include <picolibc.h>
+
+/* lock-futex.c provides real locks for hosted Linux builds */
+#if !defined(__SINGLE_THREAD__) && !defined(__PICOLIBC_FUTEX_LOCKING)
 
 #include <sys/lock.h>
 
@@ -87,6 +93,16 @@ struct __lock {
   char unused;
 };
 
+#ifdef __PICOLIBC_SUBSYSTEM_LOCKS
+struct __lock __lock___atexit_recursive_mutex;
+struct __lock __lock___at_quick_exit_mutex;
+struct __lock __lock___sfp_recursive_mutex;
+struct __lock __lock___locale_mutex;
+struct __lock __lock___tz_mutex;
+struct __lock __lock___env_recursive_mutex;
+struct __lock __lock___arc4random_mutex;
+struct __lock __lock___malloc_recursive_mutex;
+#endif
 struct __lock __lock___libc_recursive_mutex;
 
 void
@@ -151,4 +167,4 @@ __retarget_lock_release_recursive (_LOCK_T lock)
   (void) lock;
 }
 
-#endif /* !defined(__SINGLE_THREAD__) */
+#endif /* !defined(__SINGLE_THREAD__) && !defined(__PICOLIBC_FUTEX_LOCKING) */
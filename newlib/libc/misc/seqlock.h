@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Sequence counters for data which is read without a lock, shared by
+ * the getenv index and the TZ rule cache. Writers, which already hold
+ * the subsystem lock, make the count odd while they change the data.
+ * Readers note the count before reading, check it is even, and retry
+ * or take the lock if it differs afterwards.
+ */
+
+#ifndef _SEQLOCK_H_
+#define _SEQLOCK_H_
+
+#ifndef __SINGLE_THREAD__
+#include <stdatomic.h>
+typedef atomic_uint seqlock_t;
+#define seqlock_load(s)		atomic_load_explicit(s, memory_order_acquire)
+#define seqlock_store(s, v)	atomic_store_explicit(s, v, memory_order_release)
+#define seqlock_fence()		atomic_thread_fence(memory_order_acquire)
+#define seqlock_start()		atomic_thread_fence(memory_order_release)
+#else
+typedef unsigned seqlock_t;
+#define seqlock_load(s)		(*(s))
+#define seqlock_store(s, v)	(*(s) = (v))
+#define seqlock_fence()
+#define seqlock_start()
+#endif
+
+/* Make the count odd before changing the data */
+static inline void
+seqlock_write_begin (seqlock_t *s)
+{
+  seqlock_store (s, seqlock_load (s) + 1);
+  seqlock_start ();
+}
+
+/* Make the count even again once the data is consistent */
+static inline void
+seqlock_write_end (seqlock_t *s)
+{
+  seqlock_store (s, seqlock_load (s) + 1);
+}
+
+/* Non-zero if the count moved from seq while the data was read */
+static inline int
+seqlock_read_retry (seqlock_t *s, unsigned seq)
+{
+  seqlock_fence ();
+  return seqlock_load (s) != seq;
+}
+
+#endif /* _SEQLOCK_H_ */
@@ -0,0 +1,94 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <picostartup.h>
+
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+
+#include <stdio.h>
+#include "cycle-timer.h"
+
+struct __startup_time __startup_times[__STARTUP_TIMING_MAX];
+unsigned __startup_count;
+
+uint64_t __attribute__((weak))
+__startup_timer(void)
+{
+	return __cycle_timer();
+}
+
+void
+__startup_record(const char *phase, void (*func)(void), uint64_t time)
+{
+	if (__startup_count < __STARTUP_TIMING_MAX) {
+		struct __startup_time *t = &__startup_times[__startup_count++];
+		t->phase = phase;
+		t->func = func;
+		t->time = time;
+	}
+}
+
+void
+__startup_dump(void)
+{
+	uint64_t now = __startup_timer();
+	int width = 2 + 2 * sizeof(void *);
+	unsigned i;
+
+	if (!__startup_count)
+		return;
+
+	/* Deltas are printed as unsigned long so that the integer-only
+	 * printf variants can show them */
+	printf("startup timing (cycles):\n");
+	for (i = 0; i < __startup_count; i++) {
+		struct __startup_time *t = &__startup_times[i];
+		uint64_t end = i + 1 < __startup_count ? t[1].time : now;
+
+		if (t->func)
+			printf("  %-8s %*p %10lu\n", t->phase, width, (void *) (uintptr_t) t->func,
+			       (unsigned long) (end - t->time));
+		else
+			printf("  %-8s %*s %10lu\n", t->phase, width, "",
+			       (unsigned long) (end - t->time));
+	}
+	printf("  %-8s %*s %10lu\n", "startup", width, "",
+	       (unsigned long) (__startup_times[__startup_count - 1].time - __startup_times[0].time));
+
+	/* Only report once */
+	__startup_count = 0;
+}
+
+#endif /* __PICOLIBC_CRT_STARTUP_TIMING */
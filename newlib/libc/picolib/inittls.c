@@ -58,13 +58,26 @@ extern char __tdata_end[];      /* End of static tdata area */
 #endif
 
 void
-_init_tls(void *__tls)
+_init_tls_data(void *__tls)
 {
 	char *tls = __tls;
 
 	/* Copy tls initialized data */
 	memcpy(tls, __tdata_source, (uintptr_t) __tdata_size);
+}
+
+void
+_init_tls_bss(void *__tls)
+{
+	char *tls = __tls;
 
 	/* Clear tls zero data */
 	memset(tls + (uintptr_t) __tdata_size, '\0', (uintptr_t) __tbss_size);
 }
+
+void
+_init_tls(void *__tls)
+{
+	_init_tls_data(__tls);
+	_init_tls_bss(__tls);
+}
@@ -278,10 +278,10 @@ char *_llicvt (char *, long long, char);
 #define __sinit_lock_acquire()
 #define __sinit_lock_release()
 #else
-#define __sfp_lock_acquire() __LIBC_LOCK()
-#define __sfp_lock_release() __LIBC_UNLOCK()
-#define __sinit_lock_acquire() __LIBC_LOCK()
-#define __sinit_lock_release() __LIBC_UNLOCK()
+#define __sfp_lock_acquire() __SFP_LOCK()
+#define __sfp_lock_release() __SFP_UNLOCK()
+#define __sinit_lock_acquire() __SFP_LOCK()
+#define __sinit_lock_release() __SFP_UNLOCK()
 #endif
 
 /* Types used in positional argument support in vfprinf/vfwprintf.
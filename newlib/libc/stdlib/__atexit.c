@@ -65,7 +65,7 @@ __register_exitproc (int type,
   struct _on_exit_args * args;
   register struct _atexit *p;
 
-  __LIBC_LOCK();
+  __ATEXIT_LOCK();
 
   p = _atexit;
   if (p == NULL)
@@ -75,13 +75,13 @@ __register_exitproc (int type,
   if (p->_ind >= _ATEXIT_SIZE)
     {
 #if !defined (_ATEXIT_DYNAMIC_ALLOC) || !defined (MALLOC_PROVIDED)
-      __LIBC_UNLOCK();
+      __ATEXIT_UNLOCK();
       return -1;
 #else
       p = (struct _atexit *) malloc (sizeof *p);
       if (p == NULL)
 	{
-	  __LIBC_UNLOCK();
+	  __ATEXIT_UNLOCK();
 	  return -1;
 	}
       p->_ind = 0;
@@ -100,6 +100,6 @@ __register_exitproc (int type,
 	args->_is_cxa |= (1 << p->_ind);
     }
   p->_fns[p->_ind++] = fn;
-  __LIBC_UNLOCK();
+  __ATEXIT_UNLOCK();
   return 0;
 }
@@ -103,7 +103,7 @@ __call_exitprocs (int code, void *d)
   void (*fn) (void);
 
 
-  __LIBC_LOCK();
+  __ATEXIT_LOCK();
 
  restart:
 
@@ -170,5 +170,5 @@ __call_exitprocs (int code, void *d)
 	}
 #endif
     }
-    __LIBC_UNLOCK();
+    __ATEXIT_UNLOCK();
 }
@@ -49,14 +49,40 @@
 #define BLOCKSZ	64
 #define RSBUFSZ	(16*BLOCKSZ)
 
+/*
+ * Requests of at least this size get whole blocks of keystream
+ * written straight to the caller's buffer, up to DIRECTSZ bytes
+ * between rekeys
+ */
+#define DIRECTMIN	RSBUFSZ
+#define DIRECTSZ	(16*RSBUFSZ)
+
+/*
+ * With -Darc4random-per-thread=true each thread gets its own
+ * generator in thread-local storage, seeded from getentropy the first
+ * time the thread uses it, so the lock isn't needed at all. Reseeding
+ * happens per thread after the same amount of output as before.
+ */
+#if defined(__PICOLIBC_ARC4RANDOM_PER_THREAD) && defined(PICOLIBC_TLS) && \
+    !defined(__SINGLE_THREAD__)
+#define _ARC4_PER_THREAD
+#define _ARC4_THREAD_LOCAL	NEWLIB_THREAD_LOCAL
+#else
+#define _ARC4_THREAD_LOCAL
+#endif
+
+#if !defined(__SINGLE_THREAD__) && !defined(_ARC4_PER_THREAD)
+#define _ARC4_LOCKING
+#endif
+
 /* Marked MAP_INHERIT_ZERO, so zero'd out in fork children. */
-static struct _rs {
+static _ARC4_THREAD_LOCAL struct _rs {
 	size_t		rs_have;	/* valid bytes at end of rs_buf */
 	size_t		rs_count;	/* bytes till reseed */
 } *rs;
 
 /* Maybe be preserved in fork children, if _rs_allocate() decides. */
-static struct _rsx {
+static _ARC4_THREAD_LOCAL struct _rsx {
 	chacha_ctx	rs_chacha;	/* chacha context for random keystream */
 	unsigned char	rs_buf[RSBUFSZ];	/* keystream blocks */
 } *rsx;
@@ -125,8 +151,7 @@ _rs_rekey(unsigned char *dat, size_t datlen)
 	memset(rsx->rs_buf, 0, sizeof(rsx->rs_buf));
 #endif
 	/* fill rs_buf with the keystream */
-	chacha_encrypt_bytes(&rsx->rs_chacha, rsx->rs_buf,
-	    rsx->rs_buf, sizeof(rsx->rs_buf));
+	chacha_keystream(&rsx->rs_chacha, rsx->rs_buf, sizeof(rsx->rs_buf));
 	/* mix in optional user provided data */
 	if (dat) {
 		size_t i, m;
@@ -160,6 +185,16 @@ _rs_random_buf(void *_buf, size_t n)
 			n -= m;
 			rs->rs_have -= m;
 		}
+		if (n >= DIRECTMIN) {
+			/* rs_buf is empty here */
+			m = min(n, DIRECTSZ) & ~(size_t) (BLOCKSZ - 1);
+			chacha_keystream(&rsx->rs_chacha, buf, m);
+			buf += m;
+			n -= m;
+			/* new key for backtracking resistance */
+			_rs_rekey(NULL, 0);
+			continue;
+		}
 		if (rs->rs_have == 0)
 			_rs_rekey(NULL, 0);
 	}
@@ -184,11 +219,11 @@ arc4random(void)
 {
 	uint32_t val;
 
-#ifndef __SINGLE_THREAD__
+#ifdef _ARC4_LOCKING
 	_ARC4_LOCK();
 #endif
 	_rs_random_u32(&val);
-#ifndef __SINGLE_THREAD__
+#ifdef _ARC4_LOCKING
 	_ARC4_UNLOCK();
 #endif
 	return val;
@@ -197,11 +232,11 @@ arc4random(void)
 void
 arc4random_buf(void *buf, size_t n)
 {
-#ifndef __SINGLE_THREAD__
+#ifdef _ARC4_LOCKING
 	_ARC4_LOCK();
 #endif
 	_rs_random_buf(buf, n);
-#ifndef __SINGLE_THREAD__
+#ifdef _ARC4_LOCKING
 	_ARC4_UNLOCK();
 #endif
 }
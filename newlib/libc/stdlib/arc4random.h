@@ -37,13 +37,13 @@
 #include <sys/lock.h>
 #include <signal.h>
 
-#define _ARC4_LOCK() __LIBC_LOCK()
-#define _ARC4_UNLOCK() __LIBC_UNLOCK()
+#define _ARC4_LOCK() __ARC4RANDOM_LOCK()
+#define _ARC4_UNLOCK() __ARC4RANDOM_UNLOCK()
 
 #ifdef _ARC4RANDOM_DATA
 _ARC4RANDOM_DATA
 #else
-static struct {
+static _ARC4_THREAD_LOCAL struct {
 	struct _rs rs;
 	struct _rsx rsx;
 } _arc4random_data;
@@ -238,3 +238,90 @@ chacha_encrypt_bytes(chacha_ctx *x,const u8 *m,u8 *c,u32 bytes)
 #endif
   }
 }
+
+#ifdef KEYSTREAM_ONLY
+
+/*
+ * Multi-block keystream generation. Each vector holds the same state
+ * word from CHACHA_LANES consecutive blocks, so the rounds run on all
+ * of them at once. This uses the compiler's generic vector support,
+ * which maps to AVX2 or SSE2 on x86 and NEON on ARM; other targets,
+ * including RISC-V where fixed-size generic vectors aren't reliably
+ * lowered to RVV, only use the scalar code above.
+ */
+#if defined(__GNUC__) && defined(__AVX2__)
+#define CHACHA_LANES 8
+#elif defined(__GNUC__) && (defined(__SSE2__) || defined(__ARM_NEON))
+#define CHACHA_LANES 4
+#endif
+
+#ifdef CHACHA_LANES
+
+typedef u32 chacha_vec __attribute__((vector_size(CHACHA_LANES * 4)));
+
+#define VROTATE(v,c) (((v) << (c)) | ((v) >> (32 - (c))))
+
+#define VQUARTERROUND(a,b,c,d) \
+  a += b; d = VROTATE(d ^ a,16); \
+  c += d; b = VROTATE(b ^ c,12); \
+  a += b; d = VROTATE(d ^ a, 8); \
+  c += d; b = VROTATE(b ^ c, 7);
+
+/* Generate CHACHA_LANES blocks of keystream */
+static void
+chacha_keystream_lanes(chacha_ctx *x,u8 *c)
+{
+  chacha_vec v[16], j[16], ctr;
+  u_int i, b;
+
+  for (i = 0;i < 16;++i) {
+    chacha_vec w = { 0 };
+    j[i] = w + x->input[i];
+  }
+  ctr = j[12];
+  for (b = 0;b < CHACHA_LANES;++b)
+    j[12][b] += b;
+  /* carry into the high word of the block counter */
+  j[13] -= (chacha_vec) (j[12] < ctr);
+
+  for (i = 0;i < 16;++i)
+    v[i] = j[i];
+  for (i = 20;i > 0;i -= 2) {
+    VQUARTERROUND( v[0], v[4], v[8],v[12])
+    VQUARTERROUND( v[1], v[5], v[9],v[13])
+    VQUARTERROUND( v[2], v[6],v[10],v[14])
+    VQUARTERROUND( v[3], v[7],v[11],v[15])
+    VQUARTERROUND( v[0], v[5],v[10],v[15])
+    VQUARTERROUND( v[1], v[6],v[11],v[12])
+    VQUARTERROUND( v[2], v[7], v[8],v[13])
+    VQUARTERROUND( v[3], v[4], v[9],v[14])
+  }
+  for (i = 0;i < 16;++i)
+    v[i] += j[i];
+
+  for (b = 0;b < CHACHA_LANES;++b)
+    for (i = 0;i < 16;++i)
+      U32TO8_LITTLE(c + 64 * b + 4 * i, v[i][b]);
+
+  x->input[12] = PLUS(x->input[12], CHACHA_LANES);
+  if (x->input[12] < CHACHA_LANES)
+    x->input[13] = PLUSONE(x->input[13]);
+}
+
+#endif /* CHACHA_LANES */
+
+/* Fill c with bytes of keystream */
+static void
+chacha_keystream(chacha_ctx *x,u8 *c,u32 bytes)
+{
+#ifdef CHACHA_LANES
+  while (bytes >= CHACHA_LANES * 64) {
+    chacha_keystream_lanes(x, c);
+    c += CHACHA_LANES * 64;
+    bytes -= CHACHA_LANES * 64;
+  }
+#endif
+  chacha_encrypt_bytes(x, c, c, bytes);
+}
+
+#endif /* KEYSTREAM_ONLY */
@@ -63,6 +63,156 @@ extern char **environ;
    'environ'.  */
 static char ***p_environ = &environ;
 
+#ifdef __PICOLIBC_GETENV_HASH
+
+/*
+ * Hash index over environ, enabled with -Dgetenv-hash=true. Each slot
+ * holds the top 16 bits of the name's hash and the entry's offset + 1;
+ * zero marks an empty slot. The index is rebuilt on the next lookup
+ * after setenv/unsetenv change the environment or after environ is
+ * assigned a different array. Environments with more than half as
+ * many entries as there are slots are searched linearly instead.
+ *
+ * __env_generation works as a sequence lock: it is odd while environ
+ * or the index is being changed. Lookups made while it stays the same
+ * even value don't need ENV_LOCK. Neither entry strings nor the
+ * environ arrays themselves are freed by setenv or unsetenv (setenv
+ * keeps the array it replaces), so a pointer read from environ stays
+ * safe to compare once the generation has been checked.
+ */
+
+#include <stdint.h>
+#include "../misc/seqlock.h"
+
+#ifndef __GETENV_HASH_SIZE
+#define __GETENV_HASH_SIZE	1024	/* must be a power of two */
+#endif
+
+#define ENV_INDEX_MASK	(__GETENV_HASH_SIZE - 1)
+
+static seqlock_t __env_generation;
+
+/* Generation the index was built for; odd means never built */
+static seqlock_t env_index_generation = 1;
+static char **env_index_environ;
+static int env_index_count;	/* entries in env_index_environ */
+static int env_index_full;
+static uint32_t env_index[__GETENV_HASH_SIZE];
+
+void
+__env_modify_begin (void)
+{
+  seqlock_write_begin (&__env_generation);
+}
+
+void
+__env_modify_end (void)
+{
+  seqlock_write_end (&__env_generation);
+}
+
+static uint32_t
+env_hash (const char *name, int len)
+{
+  uint32_t h = 2166136261U;
+
+  while (len--)
+    h = (h ^ (unsigned char) *name++) * 16777619U;
+  return h;
+}
+
+static int
+env_match (const char *entry, const char *name, int len)
+{
+  return !strncmp (entry, name, len) && entry[len] == '=';
+}
+
+/*
+ * Find name in the index built for env. Returns the offset, -1 when
+ * the name isn't there or -2 when the generation changed from gen.
+ */
+static int
+env_index_find (char **env, const char *name, int len, unsigned gen,
+		char **entry)
+{
+  uint32_t h = env_hash (name, len);
+  unsigned i = h & ENV_INDEX_MASK;
+  uint32_t e;
+
+  while ((e = env_index[i]) != 0)
+    {
+      if ((e >> 16) == (h >> 16))
+	{
+	  int off = (int) (e & 0xffff) - 1;
+	  char *p;
+
+	  /*
+	   * env itself is never freed, but the index may have been
+	   * rebuilt for a longer array since. Make sure the entry and
+	   * count read above still belong to env before using them
+	   */
+	  if (off >= env_index_count ||
+	      seqlock_read_retry (&__env_generation, gen))
+	    return -2;
+	  p = env[off];
+	  if (seqlock_read_retry (&__env_generation, gen))
+	    return -2;
+	  if (env_match (p, name, len))
+	    {
+	      *entry = p;
+	      return off;
+	    }
+	}
+      i = (i + 1) & ENV_INDEX_MASK;
+    }
+  if (seqlock_read_retry (&__env_generation, gen))
+    return -2;
+  return -1;
+}
+
+/* Rebuild the index for env, called with ENV_LOCK held */
+static void
+env_index_build (char **env)
+{
+  int cnt, off, len;
+  uint32_t h;
+  unsigned i;
+
+  for (cnt = 0; env[cnt]; cnt++)
+    ;
+
+  __env_modify_begin ();
+  env_index_full = cnt > __GETENV_HASH_SIZE / 2 || cnt >= 0xffff;
+  if (!env_index_full)
+    {
+      memset (env_index, 0, sizeof (env_index));
+      for (off = 0; off < cnt; off++)
+	{
+	  const char *c = strchr (env[off], '=');
+
+	  if (!c)
+	    continue;
+	  len = c - env[off];
+	  h = env_hash (env[off], len);
+	  for (i = h & ENV_INDEX_MASK; env_index[i]; i = (i + 1) & ENV_INDEX_MASK)
+	    {
+	      /* Keep the first of duplicate entries, like the linear scan */
+	      if ((env_index[i] >> 16) == (h >> 16) &&
+		  env_match (env[(env_index[i] & 0xffff) - 1], env[off], len))
+		break;
+	    }
+	  if (!env_index[i])
+	    env_index[i] = (h & 0xffff0000) | (off + 1);
+	}
+    }
+  env_index_environ = env;
+  env_index_count = cnt;
+  __env_modify_end ();
+  seqlock_store (&env_index_generation, seqlock_load (&__env_generation));
+}
+
+#endif /* __PICOLIBC_GETENV_HASH */
+
 /*
  * _findenv --
  *	Returns pointer to value associated with name, if any, else NULL.
@@ -80,6 +230,33 @@ _findenv (
   register int len;
   register char **p;
   const char *c;
+#ifdef __PICOLIBC_GETENV_HASH
+  unsigned gen;
+  char *entry;
+  int off;
+#endif
+
+#if defined(__PICOLIBC_GETENV_HASH) && !defined(__SINGLE_THREAD__)
+  /* Try the index without taking the lock */
+  gen = seqlock_load (&__env_generation);
+  p = *p_environ;
+  if (!(gen & 1) && p && p == env_index_environ &&
+      gen == seqlock_load (&env_index_generation) && !env_index_full)
+    {
+      c = name;
+      while (*c && *c != '=')  c++;
+      if (*c == '=')
+	return NULL;
+      off = env_index_find (p, name, c - name, gen, &entry);
+      if (off == -1)
+	return NULL;
+      if (off >= 0)
+	{
+	  *offset = off;
+	  return entry + (c - name) + 1;
+	}
+    }
+#endif
 
   ENV_LOCK;
 
@@ -98,6 +275,29 @@ _findenv (
   if(*c != '=')
     {
     len = c - name;
+#ifdef __PICOLIBC_GETENV_HASH
+    /* The generation is odd while setenv or unsetenv, which hold the
+       lock, are changing the environment; scan it linearly then */
+    gen = seqlock_load (&__env_generation);
+    if (!(gen & 1))
+      {
+	if (*p_environ != env_index_environ ||
+	    gen != seqlock_load (&env_index_generation))
+	  {
+	    env_index_build (*p_environ);
+	    gen = seqlock_load (&__env_generation);
+	  }
+	if (!env_index_full)
+	  {
+	    off = env_index_find (*p_environ, name, len, gen, &entry);
+	    ENV_UNLOCK;
+	    if (off < 0)
+	      return NULL;
+	    *offset = off;
+	    return entry + len + 1;
+	  }
+      }
+#endif
     for (p = *p_environ; *p; ++p)
       if (!strncmp (*p, name, len))
         if (*(c = *p + len) == '=')
@@ -306,8 +306,8 @@ extern "C" {
 #define HAVE_MMAP 0
 #define MORECORE(size) sbrk((size))
 #define MORECORE_CLEARS 0
-#define MALLOC_LOCK __LIBC_LOCK()
-#define MALLOC_UNLOCK __LIBC_UNLOCK()
+#define MALLOC_LOCK __MALLOC_LOCK()
+#define MALLOC_UNLOCK __MALLOC_UNLOCK()
 
 #ifdef __CYGWIN__
 # undef _WIN32
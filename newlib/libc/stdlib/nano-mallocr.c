@@ -45,11 +45,11 @@
 
 #if MALLOC_DEBUG
 #include <assert.h>
-#define MALLOC_LOCK do { __LIBC_LOCK(); __malloc_validate(); } while(0)
-#define MALLOC_UNLOCK do { __malloc_validate(); __LIBC_UNLOCK(); } while(0)
+#define MALLOC_LOCK do { __MALLOC_LOCK(); __malloc_validate(); } while(0)
+#define MALLOC_UNLOCK do { __malloc_validate(); __MALLOC_UNLOCK(); } while(0)
 #else
-#define MALLOC_LOCK __LIBC_LOCK()
-#define MALLOC_UNLOCK __LIBC_UNLOCK()
+#define MALLOC_LOCK __MALLOC_LOCK()
+#define MALLOC_UNLOCK __MALLOC_UNLOCK()
 #undef assert
 #define assert(x) ((void)0)
 #endif
@@ -56,10 +56,10 @@ at_quick_exit(void (*func)(void))
 	if (NULL == h)
 		return (1);
 	h->cleanup = func;
-	__LIBC_LOCK();
+	__AT_QUICK_EXIT_LOCK();
 	h->next = handlers;
 	handlers = h;
-	__LIBC_UNLOCK();
+	__AT_QUICK_EXIT_UNLOCK();
 	return (0);
 }
 
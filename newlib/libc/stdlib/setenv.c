@@ -37,12 +37,20 @@ extern char **environ;
    'environ'.  */
 static char ***p_environ = &environ;
 
+#if defined(__PICOLIBC_GETENV_HASH) && !defined(__SINGLE_THREAD__)
+/* The array setenv last allocated and how many entries it holds */
+static char **env_array;
+static int env_size;
+#endif
+
 int
 setenv (const char *name,
 	const char *value,
 	int rewrite)
 {
+#if !defined(__PICOLIBC_GETENV_HASH) || defined(__SINGLE_THREAD__)
   static int alloced;		/* if allocated space before */
+#endif
   register char *C;
   size_t l_value;
   int offset;
@@ -53,20 +61,20 @@ setenv (const char *name,
       return -1;
     }
 
-  ENV_LOCK;
+  ENV_MODIFY_LOCK;
 
   l_value = strlen (value);
   if ((C = _findenv (name, &offset)))
     {				/* find if already exists */
       if (!rewrite)
         {
-          ENV_UNLOCK;
+          ENV_MODIFY_UNLOCK;
 	  return 0;
         }
       if (strlen (C) >= l_value)
 	{			/* old larger; copy over */
 	  strcpy(C, value);
-          ENV_UNLOCK;
+          ENV_MODIFY_UNLOCK;
 	  return 0;
 	}
     }
@@ -76,13 +84,36 @@ setenv (const char *name,
       register char **P;
 
       for (P = *p_environ, cnt = 0; *P; ++P, ++cnt);
+#if defined(__PICOLIBC_GETENV_HASH) && !defined(__SINGLE_THREAD__)
+      /*
+       * getenv may be reading the current array without the lock,
+       * so it is never freed. Arrays grow by doubling to keep the
+       * retired ones no larger in total than the current one
+       */
+      if (*p_environ != env_array || cnt + 2 > env_size)
+	{
+	  int size = cnt + 2;
+
+	  if (*p_environ == env_array && size < 2 * env_size)
+	    size = 2 * env_size;
+	  P = (char **) malloc ((size_t) (sizeof (char *) * size));
+	  if (!P)
+            {
+              ENV_MODIFY_UNLOCK;
+	      return (-1);
+            }
+	  memcpy((char *) P,(char *) *p_environ, cnt * sizeof (char *));
+	  *p_environ = env_array = P;
+	  env_size = size;
+	}
+#else
       if (alloced)
 	{			/* just increase size */
 	  *p_environ = (char **) realloc ((char *) environ,
 					     (size_t) (sizeof (char *) * (cnt + 2)));
 	  if (!*p_environ)
             {
-              ENV_UNLOCK;
+              ENV_MODIFY_UNLOCK;
 	      return -1;
             }
 	}
@@ -92,12 +123,13 @@ setenv (const char *name,
 	  P = (char **) malloc ((size_t) (sizeof (char *) * (cnt + 2)));
 	  if (!P)
             {
-              ENV_UNLOCK;
+              ENV_MODIFY_UNLOCK;
 	      return (-1);
             }
 	  memcpy((char *) P,(char *) *p_environ, cnt * sizeof (char *));
 	  *p_environ = P;
 	}
+#endif
       (*p_environ)[cnt + 1] = NULL;
       offset = cnt;
     }
@@ -105,13 +137,13 @@ setenv (const char *name,
   if (!((*p_environ)[offset] =	/* name + `=' + value */
 	malloc ((size_t) ((int) (C - name) + l_value + 2))))
     {
-      ENV_UNLOCK;
+      ENV_MODIFY_UNLOCK;
       return -1;
     }
   for (C = (*p_environ)[offset]; (*C = *name++) && *C != '='; ++C);
   for (*C++ = '='; (*C++ = *value++) != 0;);
 
-  ENV_UNLOCK;
+  ENV_MODIFY_UNLOCK;
 
   return 0;
 }
@@ -133,7 +165,7 @@ unsetenv (const char *name)
       return -1;
     }
 
-  ENV_LOCK;
+  ENV_MODIFY_LOCK;
 
   while (_findenv (name, &offset))	/* if set multiple times */
     { 
@@ -142,7 +174,7 @@ unsetenv (const char *name)
 	  break;
     }
 
-  ENV_UNLOCK;
+  ENV_MODIFY_UNLOCK;
   return 0;
 }
 
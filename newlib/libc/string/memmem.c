@@ -96,16 +96,18 @@ memmem (const void *haystack, size_t hs_len, const void *needle, size_t ne_len)
 # define RETURN_TYPE void *
 # define AVAILABLE(h, h_l, j, n_l) ((j) <= (h_l) - (n_l))
 # include "str-two-way.h"
+# include "str-prefilter.h"
 
 #define hash2(p) (((size_t)(p)[0] - ((size_t)(p)[-1] << 3)) % sizeof (shift))
 
 /* Fast memmem algorithm with guaranteed linear-time performance.
-   Small needles up to size 2 use a dedicated linear search.  Longer needles
-   up to size 256 use a novel modified Horspool algorithm.  It hashes pairs
-   of characters to quickly skip past mismatches.  The main search loop only
-   exits if the last 2 characters match, avoiding unnecessary calls to memcmp
-   and allowing for a larger skip if there is no match.  A self-adapting
-   filtering check is used to quickly detect mismatches in long needles.
+   Small needles up to size 16 use a word-at-a-time search for the first
+   and last needle characters.  Longer needles up to size 256 use a novel
+   modified Horspool algorithm.  It hashes pairs of characters to quickly
+   skip past mismatches.  The main search loop only exits if the last 2
+   characters match, avoiding unnecessary calls to memcmp and allowing for
+   a larger skip if there is no match.  A self-adapting filtering check is
+   used to quickly detect mismatches in long needles.
    By limiting the needle length to 256, the shift table can be reduced to 8
    bits per entry, lowering preprocessing overhead and minimizing cache effects.
    The limit also implies worst-case performance is linear.
@@ -125,15 +127,10 @@ memmem (const void *haystack, size_t hs_len, const void *needle, size_t ne_len)
   if (hs_len < ne_len)
     return NULL;
 
-  const unsigned char *end = hs + hs_len - ne_len;
+  if (ne_len <= PREFILTER_MAX_NEEDLE)
+    return (void *) __prefilter_search (hs, hs_len, ne, ne_len, 0);
 
-  if (ne_len == 2)
-    {
-      uint32_t nw = (uint32_t) ne[0] << 16 | ne[1], hw = (uint32_t) hs[0] << 16 | hs[1];
-      for (hs++; hs <= end && hw != nw; )
-	hw = hw << 16 | *++hs;
-      return hw == nw ? (void *)(hs - 1) : NULL;
-    }
+  const unsigned char *end = hs + hs_len - ne_len;
 
   /* Use Two-Way algorithm for very long needles.  */
   if (__builtin_expect (ne_len > 256, 0))
@@ -0,0 +1,177 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Short needle search for strstr, memmem and strcasestr.
+ *
+ * Candidate positions are located a word at a time by comparing the
+ * first and last needle bytes against two overlapping haystack words,
+ * one starting at the candidate and one starting ne_len - 1 bytes
+ * later. Only words which may hold a match get checked byte by byte,
+ * and only positions matching both ends are compared in full.
+ */
+
+#ifndef _STR_PREFILTER_H_
+#define _STR_PREFILTER_H_
+
+#include <ctype.h>
+#include <stddef.h>
+#include <string.h>
+#include <strings.h>
+
+/* Longest needle handled here; longer ones use the skip-table searches */
+#define PREFILTER_MAX_NEEDLE	16
+
+#define PREFILTER_ONES		(~0UL / 0xff)
+#define PREFILTER_HIGHS		(PREFILTER_ONES << 7)
+
+/*
+ * Nonzero if any byte of X is zero. Bytes above a zero byte may also be
+ * flagged, which only costs a wasted check here.
+ */
+#define PREFILTER_HAS_ZERO(X)	(((X) - PREFILTER_ONES) & ~(X) & PREFILTER_HIGHS)
+
+/*
+ * Case-insensitive matching relies on tolower only folding ASCII
+ * letters, which isn't true with the extended single-byte charsets
+ */
+#if defined (_MB_EXTENDED_CHARSETS_ISO) || defined (_MB_EXTENDED_CHARSETS_WINDOWS)
+#define PREFILTER_FOLD	0
+#else
+#define PREFILTER_FOLD	1
+#endif
+
+static inline unsigned long
+__prefilter_load (const unsigned char *p)
+{
+  unsigned long w;
+
+  memcpy (&w, p, sizeof (w));
+  return w;
+}
+
+/* Flag bytes of W equal to either LO or HI (both splatted) */
+static inline unsigned long
+__prefilter_match (unsigned long w, unsigned long lo, unsigned long hi, int fold)
+{
+  if (fold)
+    return PREFILTER_HAS_ZERO (w ^ lo) | PREFILTER_HAS_ZERO (w ^ hi);
+  return PREFILTER_HAS_ZERO (w ^ lo);
+}
+
+static inline int
+__prefilter_verify (const unsigned char *hs, const unsigned char *ne, size_t ne_len, int fold)
+{
+  if (fold)
+    return strncasecmp ((const char *) hs, (const char *) ne, ne_len) == 0;
+  return memcmp (hs, ne, ne_len) == 0;
+}
+
+/*
+ * Search the first HS_LEN bytes of HS for the 2 to PREFILTER_MAX_NEEDLE
+ * byte needle NE. HS_LEN must be at least NE_LEN.
+ */
+static inline const unsigned char *
+__prefilter_search (const unsigned char *hs, size_t hs_len,
+		    const unsigned char *ne, size_t ne_len, int fold)
+{
+  size_t n = hs_len - ne_len + 1;	/* number of candidate positions */
+  size_t m1 = ne_len - 1;
+  unsigned char f = ne[0], l = ne[m1];
+  unsigned long f_lo, f_hi, l_lo, l_hi;
+  size_t i;
+
+  if (fold)
+    {
+      f = tolower (f);
+      l = tolower (l);
+    }
+  f_lo = f_hi = PREFILTER_ONES * f;
+  l_lo = l_hi = PREFILTER_ONES * l;
+  if (fold)
+    {
+      f_hi = PREFILTER_ONES * (unsigned char) toupper (f);
+      l_hi = PREFILTER_ONES * (unsigned char) toupper (l);
+    }
+
+  for (; n >= sizeof (long); n -= sizeof (long), hs += sizeof (long))
+    {
+      unsigned long cand;
+
+      if (fold)
+	cand = __prefilter_match (__prefilter_load (hs), f_lo, f_hi, 1)
+	  & __prefilter_match (__prefilter_load (hs + m1), l_lo, l_hi, 1);
+      else
+	cand = PREFILTER_HAS_ZERO ((__prefilter_load (hs) ^ f_lo)
+				   | (__prefilter_load (hs + m1) ^ l_lo));
+      if (cand)
+	for (i = 0; i < sizeof (long); i++)
+	  if ((fold ? tolower (hs[i + m1]) : hs[i + m1]) == l
+	      && __prefilter_verify (hs + i, ne, ne_len, fold))
+	    return hs + i;
+    }
+
+  for (; n; n--, hs++)
+    if (__prefilter_verify (hs, ne, ne_len, fold))
+      return hs;
+
+  return NULL;
+}
+
+/*
+ * Search the NUL-terminated HS for NE, walking the haystack in chunks
+ * whose length has been found with strnlen.
+ */
+static inline const unsigned char *
+__prefilter_strsearch (const unsigned char *hs, const unsigned char *ne,
+		       size_t ne_len, int fold)
+{
+  size_t hs_len = strnlen ((const char *) hs, ne_len | 512);
+  const unsigned char *r;
+
+  if (hs_len < ne_len)
+    return NULL;
+  for (;;)
+    {
+      r = __prefilter_search (hs, hs_len, ne, ne_len, fold);
+      if (r || hs[hs_len] == 0)
+	return r;
+      /* Resume at the first position not yet checked */
+      hs += hs_len - ne_len + 1;
+      hs_len = ne_len - 1 + strnlen ((const char *) hs + ne_len - 1, 2048);
+    }
+}
+
+#endif /* _STR_PREFILTER_H_ */
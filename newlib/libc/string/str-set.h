@@ -0,0 +1,120 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Character sets for the span and break functions (strspn, strcspn,
+ * strpbrk, strtok_r, strsep and the wide versions).
+ *
+ * The set is built once per call as a 256-bit bitmap on the stack,
+ * so testing each input character is a single lookup instead of a
+ * walk along the set string. Wide sets use the same bitmap for
+ * values below 256 and only walk the set string for larger values,
+ * and only when the set contains any.
+ */
+
+#ifndef _STR_SET_H_
+#define _STR_SET_H_
+
+#include <limits.h>
+#include <string.h>
+#include <wchar.h>
+
+#define STRSET_LONG_BITS	(sizeof (unsigned long) * CHAR_BIT)
+
+struct strset {
+    unsigned long bits[256 / STRSET_LONG_BITS];
+};
+
+static inline void
+strset_add (struct strset *set, unsigned int c)
+{
+  set->bits[c / STRSET_LONG_BITS] |= 1UL << (c % STRSET_LONG_BITS);
+}
+
+static inline int
+strset_has (const struct strset *set, unsigned char c)
+{
+  return (set->bits[c / STRSET_LONG_BITS] >> (c % STRSET_LONG_BITS)) & 1;
+}
+
+/* Fill the set from 'chars', adding NUL when 'nul' is non-zero */
+static inline void
+strset_init (struct strset *set, const char *chars, int nul)
+{
+  memset (set, 0, sizeof (*set));
+  while (*chars)
+    strset_add (set, (unsigned char) *chars++);
+  if (nul)
+    strset_add (set, 0);
+}
+
+struct wcsset {
+    struct strset	low;	/* values below 256 */
+    const wchar_t	*wide;	/* set string when it has larger values */
+};
+
+static inline void
+wcsset_init (struct wcsset *set, const wchar_t *chars, int nul)
+{
+  const wchar_t *c;
+
+  memset (&set->low, 0, sizeof (set->low));
+  set->wide = NULL;
+  for (c = chars; *c; c++)
+    {
+      if ((unsigned long) *c < 256)
+	strset_add (&set->low, (unsigned int) *c);
+      else
+	set->wide = chars;
+    }
+  if (nul)
+    strset_add (&set->low, 0);
+}
+
+static inline int
+wcsset_has (const struct wcsset *set, wchar_t c)
+{
+  const wchar_t *w;
+
+  if ((unsigned long) c < 256)
+    return strset_has (&set->low, (unsigned char) c);
+  if ((w = set->wide) != NULL)
+    for (; *w; w++)
+      if (*w == c)
+	return 1;
+  return 0;
+}
+
+#endif /* _STR_SET_H_ */
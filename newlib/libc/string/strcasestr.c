@@ -84,6 +84,7 @@ QUICKREF
 #endif
 # define CMP_FUNC strncasecmp
 # include "str-two-way.h"
+# include "str-prefilter.h"
 #endif
 
 /*
@@ -121,6 +122,15 @@ strcasestr (const char *s,
   size_t haystack_len; /* Known minimum length of HAYSTACK.  */
   int ok = 1; /* True if NEEDLE is prefix of HAYSTACK.  */
 
+#if PREFILTER_FOLD
+  /* Short needles use a word-at-a-time search for their end characters.  */
+  needle_len = strnlen (find, PREFILTER_MAX_NEEDLE + 1);
+  if (needle_len >= 2 && needle_len <= PREFILTER_MAX_NEEDLE)
+    return (char *) __prefilter_strsearch ((const unsigned char *) s,
+					   (const unsigned char *) find,
+					   needle_len, 1);
+#endif
+
   /* Determine length of NEEDLE, and in the process, make sure
      HAYSTACK is at least as long (no point processing all of a long
      NEEDLE if HAYSTACK is too short).  */
@@ -40,12 +40,14 @@ PORTABILITY
  */
 
 #include <string.h>
+#include "str-set.h"
 
 size_t
 strcspn (const char *s1,
 	const char *s2)
 {
   const char *s = s1;
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
   const char *c;
 
   while (*s1)
@@ -59,6 +61,21 @@ strcspn (const char *s1,
 	break;
       s1++;
     }
+#else
+  struct strset set;
+
+  /* A single delimiter can use the (often vectorized) strchr */
+  if (s2[0] && !s2[1])
+    {
+      const char *c = strchr (s1, s2[0]);
+
+      return c ? (size_t) (c - s1) : strlen (s1);
+    }
+
+  strset_init (&set, s2, 1);
+  while (!strset_has (&set, (unsigned char) *s1))
+    s1++;
+#endif
 
   return s1 - s;
 }
@@ -39,11 +39,13 @@ PORTABILITY
 */
 
 #include <string.h>
+#include "str-set.h"
 
 char *
 strpbrk (const char *s1,
 	const char *s2)
 {
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
   const char *c = s2;
   if (!*s1)
     return (char *) NULL;
@@ -64,4 +66,17 @@ strpbrk (const char *s1,
     s1 = NULL;
 
   return (char *) s1;
+#else
+  struct strset set;
+
+  /* A single character can use the (often vectorized) strchr */
+  if (s2[0] && !s2[1])
+    return strchr (s1, s2[0]);
+
+  strset_init (&set, s2, 1);
+  while (!strset_has (&set, (unsigned char) *s1))
+    s1++;
+
+  return *s1 ? (char *) s1 : NULL;
+#endif
 }
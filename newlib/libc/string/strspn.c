@@ -44,12 +44,14 @@ QUICKREF
 */
 
 #include <string.h>
+#include "str-set.h"
 
 size_t
 strspn (const char *s1,
 	const char *s2)
 {
   const char *s = s1;
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
   const char *c;
 
   while (*s1)
@@ -63,6 +65,13 @@ strspn (const char *s1,
 	break;
       s1++;
     }
+#else
+  struct strset set;
+
+  strset_init (&set, s2, 0);
+  while (strset_has (&set, (unsigned char) *s1))
+    s1++;
+#endif
 
   return s1 - s;
 }
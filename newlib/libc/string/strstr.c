@@ -111,47 +111,17 @@ strstr (const char *hs, const char *ne)
 
 # include "str-two-way.h"
 
+# include "str-prefilter.h"
+
 /* Number of bits used to index shift table.  */
 #define SHIFT_TABLE_BITS 6
 
-static inline char *
-strstr2 (const unsigned char *hs, const unsigned char *ne)
-{
-  uint32_t h1 = ((uint32_t) ne[0] << 16) | ne[1];
-  uint32_t h2 = 0;
-  int c;
-  for (c = hs[0]; h1 != h2 && c != 0; c = *++hs)
-      h2 = (h2 << 16) | c;
-  return h1 == h2 ? (char *)hs - 2 : NULL;
-}
-
-static inline char *
-strstr3 (const unsigned char *hs, const unsigned char *ne)
-{
-  uint32_t h1 = ((uint32_t) ne[0] << 24) | ((uint32_t) ne[1] << 16) | ((uint32_t) ne[2] << 8);
-  uint32_t h2 = 0;
-  int c;
-  for (c = hs[0]; h1 != h2 && c != 0; c = *++hs)
-      h2 = (h2 | c) << 8;
-  return h1 == h2 ? (char *)hs - 3 : NULL;
-}
-
-static inline char *
-strstr4 (const unsigned char *hs, const unsigned char *ne)
-{
-  uint32_t h1 = ((uint32_t) ne[0] << 24) | ((uint32_t) ne[1] << 16) | ((uint32_t) ne[2] << 8) | ne[3];
-  uint32_t h2 = 0;
-  int c;
-  for (c = hs[0]; c != 0 && h1 != h2; c = *++hs)
-    h2 = (h2 << 8) | c;
-  return h1 == h2 ? (char *)hs - 4 : NULL;
-}
-
 /* Extremely fast strstr algorithm with guaranteed linear-time performance.
-   Small needles up to size 4 use a dedicated linear search.  Longer needles
-   up to size 254 use Sunday's Quick-Search algorithm.  Due to its simplicity
-   it has the best average performance of string matching algorithms on almost
-   all inputs.  It uses a bad-character shift table to skip past mismatches.
+   Small needles up to size 16 use a word-at-a-time search for the first
+   and last needle characters.  Longer needles up to size 254 use Sunday's
+   Quick-Search algorithm.  Due to its simplicity it has the best average
+   performance of string matching algorithms on almost all inputs.  It uses
+   a bad-character shift table to skip past mismatches.
    By limiting the needle length to 254, the shift table can be reduced to 8
    bits per entry, lowering preprocessing overhead and minimizing cache effects.
    The limit also implies the worst-case performance is linear.
@@ -169,14 +139,11 @@ strstr (const char *haystack, const char *needle)
     return (char *) hs;
   if (ne[1] == '\0')
     return (char*)strchr ((const char *) hs, (char) ne[0]);
-  if (ne[2] == '\0')
-    return strstr2 (hs, ne);
-  if (ne[3] == '\0')
-    return strstr3 (hs, ne);
-  if (ne[4] == '\0')
-    return strstr4 (hs, ne);
-
-  size_t ne_len = strlen ((const char *) ne);
+
+  size_t ne_len = strnlen ((const char *) ne, PREFILTER_MAX_NEEDLE + 1);
+  if (ne_len <= PREFILTER_MAX_NEEDLE)
+    return (char *) __prefilter_strsearch (hs, ne, ne_len, 0);
+  ne_len += strlen ((const char *) ne + ne_len);
   size_t hs_len = strnlen ((const char *) hs, ne_len | 512);
 
   /* Ensure haystack length is >= needle length.  */
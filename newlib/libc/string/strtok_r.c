@@ -28,6 +28,7 @@
  */
 
 #include <string.h>
+#include "str-set.h"
 
 char *
 __strtok_r (register char *s,
@@ -35,10 +36,10 @@ __strtok_r (register char *s,
 	char **lasts,
 	int skip_leading_delim)
 {
+	char *tok;
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
 	register char *spanp;
 	register int c, sc;
-	char *tok;
-
 
 	if (s == NULL && (s = *lasts) == NULL)
 		return (NULL);
@@ -86,6 +87,41 @@ cont:
 		} while (sc != 0);
 	}
 	/* NOTREACHED */
+#else
+	struct strset set;
+
+	if (s == NULL && (s = *lasts) == NULL)
+		return (NULL);
+
+	strset_init (&set, delim, 0);
+
+	/*
+	 * Skip (span) leading delimiters.
+	 */
+	if (skip_leading_delim)
+		while (strset_has (&set, (unsigned char) *s))
+			s++;
+
+	if (*s == 0) {		/* no non-delimiter characters */
+		*lasts = NULL;
+		return (NULL);
+	}
+	tok = s;
+
+	/*
+	 * Scan token, stopping at a delimiter or the terminating NUL.
+	 */
+	strset_add (&set, 0);
+	while (!strset_has (&set, (unsigned char) *s))
+		s++;
+	if (*s == 0) {
+		*lasts = NULL;
+	} else {
+		*s++ = 0;
+		*lasts = s;
+	}
+	return (tok);
+#endif
 }
 
 char *
@@ -23,6 +23,23 @@ timingsafe_bcmp(const void *b1, const void *b2, size_t n)
 	const unsigned char *p1 = b1, *p2 = b2;
 	int ret = 0;
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__)
+	/*
+	 * Accumulate the differences a word at a time. The loop count
+	 * depends only on n, never on the data.
+	 */
+	unsigned long w1, w2, acc = 0;
+
+	for (; n >= sizeof(long); n -= sizeof(long)) {
+		memcpy(&w1, p1, sizeof(long));
+		memcpy(&w2, p2, sizeof(long));
+		acc |= w1 ^ w2;
+		p1 += sizeof(long);
+		p2 += sizeof(long);
+	}
+	/* Fold to a 0/1 value without a data-dependent branch */
+	ret = (int) ((acc | -acc) >> (sizeof(long) * 8 - 1));
+#endif
 	for (; n > 0; n--)
 		ret |= *p1++ ^ *p2++;
 	return (ret != 0);
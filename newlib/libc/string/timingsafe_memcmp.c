@@ -18,14 +18,60 @@
 #include <limits.h>
 #include <string.h>
 
+#if !defined(PREFER_SIZE_OVER_SPEED) && !defined(__OPTIMIZE_SIZE__) \
+    && (__SIZEOF_LONG__ == 4 || __SIZEOF_LONG__ == 8) && CHAR_BIT == 8
+#define TIMINGSAFE_WORDS
+
+#define LONG_BITS	(sizeof(unsigned long) * CHAR_BIT)
+
+/* Load a word with the first byte most significant */
+static inline unsigned long
+load_be(const unsigned char *p)
+{
+	unsigned long w;
+
+	memcpy(&w, p, sizeof(w));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#if __SIZEOF_LONG__ == 8
+	w = __builtin_bswap64(w);
+#else
+	w = __builtin_bswap32(w);
+#endif
+#endif
+	return w;
+}
+
+/* 1 if a < b, else 0, computed from the borrow of a - b. */
+static inline unsigned long
+less(unsigned long a, unsigned long b)
+{
+	return ((~a & b) | ((~a | b) & (a - b))) >> (LONG_BITS - 1);
+}
+#endif
+
 int
 timingsafe_memcmp(const void *b1, const void *b2, size_t len)
 {
         const unsigned char *p1 = b1, *p2 = b2;
-        size_t i;
+        size_t i = 0;
         int res = 0, done = 0;
 
-        for (i = 0; i < len; i++) {
+#ifdef TIMINGSAFE_WORDS
+        /*
+         * Compare big-endian words so that unsigned word order matches
+         * the order of the first differing byte. Every word is
+         * processed; done masks out all but the first difference.
+         */
+        for (; len - i >= sizeof(long); i += sizeof(long)) {
+                unsigned long w1 = load_be(p1 + i), w2 = load_be(p2 + i);
+                int lt = -(int) less(w1, w2);
+                int gt = -(int) less(w2, w1);
+
+                res |= (lt - gt) & ~done;
+                done |= lt | gt;
+        }
+#endif
+        for (; i < len; i++) {
                 /* lt is -1 if p1[i] < p2[i]; else 0. */
                 int lt = (p1[i] - p2[i]) >> CHAR_BIT;
 
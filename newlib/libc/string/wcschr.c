@@ -56,6 +56,8 @@ No supporting OS subroutines are required.
 #include <_ansi.h>
 #include <stddef.h>
 #include <wchar.h>
+#include <stdint.h>
+#include "wide-swar.h"
 
 wchar_t *
 wcschr (const wchar_t * s,
@@ -64,6 +66,27 @@ wcschr (const wchar_t * s,
   const wchar_t *p;
 
   p = s;
+#ifdef WIDE_SWAR
+  const unsigned long *aligned;
+  unsigned long mask;
+
+  while (UNALIGNED (p))
+    {
+      if (*p == c)
+	return (wchar_t *) p;
+      if (!*p)
+	return NULL;
+      p++;
+    }
+
+  /* Skip pairs holding neither C nor NUL */
+  aligned = (const unsigned long *) p;
+  mask = (uint32_t) c;
+  mask |= mask << 32;
+  while (!DETECTNULL (*aligned) && !DETECTCHAR (*aligned, mask))
+    aligned++;
+  p = (const wchar_t *) aligned;
+#endif
   do
     {
       if (*p == c)
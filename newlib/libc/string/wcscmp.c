@@ -62,6 +62,8 @@ No supporting OS subroutines are required.
 
 #include <_ansi.h>
 #include <wchar.h>
+#include <stdint.h>
+#include "wide-swar.h"
 
 /*
  * Compare strings.
@@ -70,6 +72,34 @@ int
 wcscmp (const wchar_t * s1,
 	const wchar_t * s2)
 {
+#ifdef WIDE_SWAR
+  /* Compare two characters at a time when both strings line up */
+  if (UNALIGNED (s1) == UNALIGNED (s2))
+    {
+      const unsigned long *a1, *a2;
+
+      if (UNALIGNED (s1))
+	{
+	  if (*s1 != *s2)
+	    return (*s1 < *s2 ? -1 : 1);
+	  if (*s1 == 0)
+	    return (0);
+	  s1++;
+	  s2++;
+	}
+      a1 = (const unsigned long *) s1;
+      a2 = (const unsigned long *) s2;
+      while (*a1 == *a2)
+	{
+	  if (DETECTNULL (*a1))
+	    return (0);
+	  a1++;
+	  a2++;
+	}
+      s1 = (const wchar_t *) a1;
+      s2 = (const wchar_t *) a2;
+    }
+#endif
 
   while (*s1 == *s2++)
     if (*s1++ == 0)
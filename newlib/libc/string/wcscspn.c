@@ -54,12 +54,14 @@ No supporting OS subroutines are required.
 
 #include <_ansi.h>
 #include <wchar.h>
+#include "str-set.h"
 
 size_t
 wcscspn (const wchar_t * s,
 	const wchar_t * set)
 {
   const wchar_t *p;
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
   const wchar_t *q;
 
   p = s;
@@ -76,5 +78,12 @@ wcscspn (const wchar_t * s,
     }
 
 done:
+#else
+  struct wcsset wset;
+
+  wcsset_init (&wset, set, 1);
+  for (p = s; !wcsset_has (&wset, *p); p++)
+    ;
+#endif
   return (p - s);
 }
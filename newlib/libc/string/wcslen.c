@@ -53,6 +53,8 @@ No supporting OS subroutines are required.
 
 #include <_ansi.h>
 #include <wchar.h>
+#include <stdint.h>
+#include "wide-swar.h"
 
 size_t
 wcslen (const wchar_t * s)
@@ -60,6 +62,23 @@ wcslen (const wchar_t * s)
   const wchar_t *p;
 
   p = s;
+#ifdef WIDE_SWAR
+  const unsigned long *aligned;
+
+  while (UNALIGNED (p))
+    {
+      if (!*p)
+	return p - s;
+      p++;
+    }
+
+  /* Check two characters at a time for a NUL */
+  aligned = (const unsigned long *) p;
+  while (!DETECTNULL (*aligned))
+    aligned++;
+
+  p = (const wchar_t *) aligned;
+#endif
   while (*p)
     p++;
 
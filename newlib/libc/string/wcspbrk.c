@@ -55,12 +55,14 @@ No supporting OS subroutines are required.
 #include <_ansi.h>
 #include <stddef.h>
 #include <wchar.h>
+#include "str-set.h"
 
 wchar_t *
 wcspbrk (const wchar_t * s,
 	const wchar_t * set)
 {
   const wchar_t *p;
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
   const wchar_t *q;
 
   p = s;
@@ -79,4 +81,13 @@ wcspbrk (const wchar_t * s,
       p++;
     }
   return NULL;
+#else
+  struct wcsset wset;
+
+  wcsset_init (&wset, set, 1);
+  for (p = s; !wcsset_has (&wset, *p); p++)
+    ;
+  /* LINTED interface specification */
+  return *p ? (wchar_t *) p : NULL;
+#endif
 }
@@ -54,12 +54,14 @@ No supporting OS subroutines are required.
 
 #include <_ansi.h>
 #include <wchar.h>
+#include "str-set.h"
 
 size_t
 wcsspn (const wchar_t * s,
 	const wchar_t * set)
 {
   const wchar_t *p;
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
   const wchar_t *q;
 
   p = s;
@@ -78,5 +80,12 @@ wcsspn (const wchar_t * s,
     }
 
 done:
+#else
+  struct wcsset wset;
+
+  wcsset_init (&wset, set, 0);
+  for (p = s; wcsset_has (&wset, *p); p++)
+    ;
+#endif
   return (p - s);
 }
@@ -88,16 +88,17 @@ QUICKREF
  */
 
 #include <wchar.h>
+#include "str-set.h"
 
 wchar_t *
 wcstok (register wchar_t *__restrict s,
 	register const wchar_t *__restrict delim,
 	wchar_t **__restrict lasts)
 {
+	wchar_t *tok;
+#if defined(PREFER_SIZE_OVER_SPEED) || defined(__OPTIMIZE_SIZE__)
 	register const wchar_t *spanp;
 	register int c, sc;
-	wchar_t *tok;
-
 
 	if (s == NULL && (s = *lasts) == NULL)
 		return (NULL);
@@ -136,6 +137,40 @@ cont:
 		} while (sc != L'\0');
 	}
 	/* NOTREACHED */
+#else
+	struct wcsset set;
+
+	if (s == NULL && (s = *lasts) == NULL)
+		return (NULL);
+
+	wcsset_init (&set, delim, 0);
+
+	/*
+	 * Skip (span) leading delimiters.
+	 */
+	while (wcsset_has (&set, *s))
+		s++;
+
+	if (*s == L'\0') {		/* no non-delimiter characters */
+		*lasts = NULL;
+		return (NULL);
+	}
+	tok = s;
+
+	/*
+	 * Scan token, stopping at a delimiter or the terminating NUL.
+	 */
+	strset_add (&set.low, 0);
+	while (!wcsset_has (&set, *s))
+		s++;
+	if (*s == L'\0') {
+		*lasts = NULL;
+	} else {
+		*s++ = L'\0';
+		*lasts = s;
+	}
+	return (tok);
+#endif
 }
  
 /* The remainder of this file can serve as a regression test.  Compile
@@ -61,6 +61,8 @@ No supporting OS subroutines are required.
 
 #include <_ansi.h>
 #include <wchar.h>
+#include <stdint.h>
+#include "wide-swar.h"
 
 wchar_t *
 wmemchr (const wchar_t * s,
@@ -69,6 +71,31 @@ wmemchr (const wchar_t * s,
 {
   size_t i;
 
+#ifdef WIDE_SWAR
+  while (UNALIGNED (s))
+    {
+      if (!n)
+	return NULL;
+      if (*s == c)
+	return (wchar_t *) s;
+      s++;
+      n--;
+    }
+
+  if (n >= 2)
+    {
+      const unsigned long *aligned = (const unsigned long *) s;
+      unsigned long mask = (uint32_t) c;
+
+      mask |= mask << 32;
+      while (n >= 2 && !DETECTCHAR (*aligned, mask))
+	{
+	  aligned++;
+	  n -= 2;
+	}
+      s = (const wchar_t *) aligned;
+    }
+#endif
   for (i = 0; i < n; i++)
     {
       if (*s == c)
@@ -57,6 +57,8 @@ No supporting OS subroutines are required.
 
 #include <_ansi.h>
 #include <wchar.h>
+#include <stdint.h>
+#include "wide-swar.h"
 
 wchar_t	*
 wmemset (wchar_t *s,
@@ -67,6 +69,22 @@ wmemset (wchar_t *s,
 	wchar_t *p;
 
 	p = (wchar_t *)s;
+#ifdef WIDE_SWAR
+	if (n >= 4) {
+		unsigned long *aligned;
+		unsigned long fill = (uint32_t) c;
+
+		if (UNALIGNED (p)) {
+			*p++ = c;
+			n--;
+		}
+		fill |= fill << 32;
+		aligned = (unsigned long *) p;
+		for (; n >= 2; n -= 2)
+			*aligned++ = fill;
+		p = (wchar_t *) aligned;
+	}
+#endif
 	for (i = 0; i < n; i++) {
 		*p = c;
 		p++;
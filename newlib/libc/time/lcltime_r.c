@@ -38,7 +38,12 @@ localtime_r (const time_t *__restrict tim_p,
   long offset;
   int hours, mins, secs;
   int year;
+#ifdef __PICOLIBC_TZ_CACHE
+  __tzinfo_type tzinfo;
+  __tzinfo_type *const tz = &tzinfo;
+#else
   __tzinfo_type *const tz = __gettzinfo ();
+#endif
   const uint8_t *ip;
 
   res = gmtime_r (tim_p, res);
@@ -46,11 +51,16 @@ localtime_r (const time_t *__restrict tim_p,
   year = res->tm_year + YEAR_BASE;
   ip = __month_lengths[isleap(year)];
 
+#ifdef __PICOLIBC_TZ_CACHE
+  /* Work on a copy of the rules so that the lock isn't needed */
+  if (__tzcache_get (year, tz))
+#else
   TZ_LOCK;
   _tzset_unlocked ();
   if (_daylight)
+#endif
     {
-      if (year == tz->__tzyear || __tzcalc_limits (year))
+      if (year == tz->__tzyear || __tzcalc_limits_tz (tz, year))
 	res->tm_isdst = (tz->__tznorth
 	  ? (*tim_p >= tz->__tzrule[0].change
 	  && *tim_p < tz->__tzrule[1].change)
@@ -136,7 +146,9 @@ localtime_r (const time_t *__restrict tim_p,
 	  res->tm_mday = ip[res->tm_mon];
 	}
     }
+#ifndef __PICOLIBC_TZ_CACHE
   TZ_UNLOCK;
+#endif
 
   return (res);
 }
@@ -31,12 +31,18 @@ static inline int isleap (int y)
 }
 
 int         __tzcalc_limits (int __year);
+int         __tzcalc_limits_tz (__tzinfo_type *__tz, int __year);
 
 extern const uint8_t __month_lengths[2][MONSPERYEAR];
 
 void _tzset_unlocked (void);
 
+#ifdef __PICOLIBC_TZ_CACHE
+/* Copy the current rules, with limits for year when cached; returns _daylight */
+int __tzcache_get (int __year, __tzinfo_type *__tz);
+#endif
+
 /* locks for multi-threading */
-#define TZ_LOCK		__LIBC_LOCK()
-#define TZ_UNLOCK	__LIBC_UNLOCK()
+#define TZ_LOCK		__TZ_LOCK()
+#define TZ_UNLOCK	__TZ_UNLOCK()
 
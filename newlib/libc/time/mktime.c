@@ -234,6 +234,10 @@ mktime (struct tm *tim_p)
   time_t tim;
   int year;
   int isdst=0;
+  int daylight;
+#ifdef __PICOLIBC_TZ_CACHE
+  __tzinfo_type tzinfo;
+#endif
   __tzinfo_type *tz;
 
   tim = mktime_utc (tim_p, &days);
@@ -243,13 +247,21 @@ mktime (struct tm *tim_p)
 
   year = tim_p->tm_year;
 
+#ifdef __PICOLIBC_TZ_CACHE
+  /* Work on a copy of the rules so that the lock isn't needed */
+  tz = &tzinfo;
+  daylight = __tzcache_get (tim_p->tm_year + YEAR_BASE, tz);
+#else
   tz = __gettzinfo ();
 
   TZ_LOCK;
 
   _tzset_unlocked ();
 
-  if (_daylight)
+  daylight = _daylight;
+#endif
+
+  if (daylight)
     {
       int tm_isdst;
       int y = tim_p->tm_year + YEAR_BASE;
@@ -257,7 +269,7 @@ mktime (struct tm *tim_p)
       tm_isdst = tim_p->tm_isdst > 0  ?  1 : tim_p->tm_isdst;
       isdst = tm_isdst;
 
-      if (y == tz->__tzyear || __tzcalc_limits (y))
+      if (y == tz->__tzyear || __tzcalc_limits_tz (tz, y))
 	{
 	  /* calculate start of dst in dst local time and 
 	     start of std in both std local time and dst local time */
@@ -324,7 +336,9 @@ mktime (struct tm *tim_p)
   else /* otherwise assume std time */
     tim += (time_t) tz->__tzrule[0].offset;
 
+#ifndef __PICOLIBC_TZ_CACHE
   TZ_UNLOCK;
+#endif
 
   /* reset isdst flag to what we have calculated */
   tim_p->tm_isdst = isdst;
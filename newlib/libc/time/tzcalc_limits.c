@@ -12,11 +12,10 @@
 #include "local.h"
 
 int
-__tzcalc_limits (int year)
+__tzcalc_limits_tz (__tzinfo_type *tz, int year)
 {
   int days, year_days, years;
   int i, j;
-  __tzinfo_type *const tz = __gettzinfo ();
 
   if (year < EPOCH_YEAR)
     return 0;
@@ -75,3 +74,9 @@ __tzcalc_limits (int year)
 
   return 1;
 }
+
+int
+__tzcalc_limits (int year)
+{
+  return __tzcalc_limits_tz (__gettzinfo (), year);
+}
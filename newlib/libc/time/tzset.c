@@ -114,10 +114,133 @@ static char __tzname_std[TZNAME_MAX + 2];
 static char __tzname_dst[TZNAME_MAX + 2];
 static char *prev_tzenv = NULL;
 
-void
-_tzset_unlocked (void)
+#ifdef __PICOLIBC_TZ_CACHE
+
+/*
+ * Snapshot of the parsed TZ rules along with the DST change times for
+ * three consecutive years, enabled with -Dtz-cache=true. localtime_r
+ * and mktime copy the rules out of it without taking TZ_LOCK while TZ
+ * still matches the value it was built from. Otherwise they take the
+ * lock, run _tzset_unlocked and rebuild it, centred on the year being
+ * converted. Earlier years are computed in the caller's copy.
+ *
+ * tz_cache_seq works as a sequence lock: it is odd while the cache is
+ * being changed, which only happens with TZ_LOCK held. The cache is
+ * invalidated whenever _tzset_unlocked parses a different TZ value, so
+ * _timezone, _daylight and _tzname always match a valid cache.
+ */
+
+#define TZ_CACHE_YEARS	3
+#define TZ_CACHE_ENV	64	/* longer TZ values are not cached */
+
+#define TZ_CACHE_INVALID	0
+#define TZ_CACHE_UNSET		1	/* TZ is not set */
+#define TZ_CACHE_SET		2	/* TZ matches tz_cache.env */
+
+#include "../misc/seqlock.h"
+
+static struct {
+  int state;
+  int daylight;
+  int year;			/* first cached year */
+  __tzinfo_type tz;
+  time_t change[TZ_CACHE_YEARS][2];
+  char north[TZ_CACHE_YEARS];
+  char valid[TZ_CACHE_YEARS];
+  char env[TZ_CACHE_ENV + 1];	/* last byte always stays zero */
+} tz_cache;
+
+static seqlock_t tz_cache_seq;
+
+static void
+tz_cache_begin (void)
+{
+  seqlock_write_begin (&tz_cache_seq);
+}
+
+static void
+tz_cache_end (void)
+{
+  seqlock_write_end (&tz_cache_seq);
+}
+
+static void
+tz_cache_invalidate (void)
+{
+  if (tz_cache.state != TZ_CACHE_INVALID)
+    {
+      tz_cache_begin ();
+      tz_cache.state = TZ_CACHE_INVALID;
+      tz_cache_end ();
+    }
+}
+
+/* Build the cache for the rules just parsed from tzenv */
+static void
+tz_cache_build (const char *tzenv, int year)
+{
+  __tzinfo_type tz = *__gettzinfo ();
+  int i;
+
+  if (tzenv && strlen (tzenv) >= TZ_CACHE_ENV)
+    return;
+
+  tz_cache_begin ();
+  tz_cache.state = tzenv ? TZ_CACHE_SET : TZ_CACHE_UNSET;
+  if (tzenv)
+    strcpy (tz_cache.env, tzenv);
+  tz_cache.daylight = _daylight;
+  tz_cache.tz = tz;
+  tz_cache.year = year - 1;
+  for (i = 0; i < TZ_CACHE_YEARS; i++)
+    {
+      tz_cache.valid[i] = __tzcalc_limits_tz (&tz, tz_cache.year + i);
+      tz_cache.change[i][0] = tz.__tzrule[0].change;
+      tz_cache.change[i][1] = tz.__tzrule[1].change;
+      tz_cache.north[i] = tz.__tznorth;
+    }
+  tz_cache_end ();
+}
+
+/*
+ * Copy the cached rules for tzenv to *tz, returning the daylight flag,
+ * or -1 when the cache doesn't match tzenv, covers only earlier years
+ * or changed while being read
+ */
+static int
+tz_cache_read (const char *tzenv, int year, __tzinfo_type *tz)
+{
+  unsigned seq = seqlock_load (&tz_cache_seq);
+  int daylight, i;
+
+  if (seq & 1)
+    return -1;
+  if (tz_cache.state != (tzenv ? TZ_CACHE_SET : TZ_CACHE_UNSET))
+    return -1;
+  if (tzenv && strcmp (tzenv, tz_cache.env) != 0)
+    return -1;
+  i = year - tz_cache.year;
+  if (i >= TZ_CACHE_YEARS)
+    return -1;
+  *tz = tz_cache.tz;
+  daylight = tz_cache.daylight;
+  if (i >= 0 && tz_cache.valid[i])
+    {
+      tz->__tzrule[0].change = tz_cache.change[i][0];
+      tz->__tzrule[1].change = tz_cache.change[i][1];
+      tz->__tznorth = tz_cache.north[i];
+      tz->__tzyear = year;
+    }
+  if (seqlock_read_retry (&tz_cache_seq, seq))
+    return -1;
+  return daylight;
+}
+
+#endif /* __PICOLIBC_TZ_CACHE */
+
+static void
+_tzset_env (const char *tzenv)
 {
-  char *tzenv;
   unsigned short hh, mm, ss, m, w, d;
   int sign, n;
   int i, ch;
@@ -125,8 +248,12 @@ _tzset_unlocked (void)
   __tzinfo_type *tz = __gettzinfo ();
   static const struct __tzrule_struct default_tzrule = {'J', 0, 0, 0, 0, (time_t)0, 0L };
 
-  if ((tzenv = getenv ("TZ")) == NULL)
+  if (tzenv == NULL)
       {
+#ifdef __PICOLIBC_TZ_CACHE
+	if (tz_cache.state != TZ_CACHE_UNSET)
+	  tz_cache_invalidate ();
+#endif
 	_timezone = 0;
 	_daylight = 0;
 	_tzname[0] = "GMT";
@@ -141,6 +268,10 @@ _tzset_unlocked (void)
   if (prev_tzenv != NULL && strcmp(tzenv, prev_tzenv) == 0)
     return;
 
+#ifdef __PICOLIBC_TZ_CACHE
+  tz_cache_invalidate ();
+#endif
+
   free(prev_tzenv);
   prev_tzenv = malloc (strlen(tzenv) + 1);
   if (prev_tzenv != NULL)
@@ -349,6 +480,12 @@ _tzset_unlocked (void)
   _daylight = tz->__tzrule[0].offset != tz->__tzrule[1].offset;
 }
 
+void
+_tzset_unlocked (void)
+{
+  _tzset_env (getenv ("TZ"));
+}
+
 void
 tzset (void)
 {
@@ -356,3 +493,30 @@ tzset (void)
   _tzset_unlocked ();
   TZ_UNLOCK;
 }
+
+#ifdef __PICOLIBC_TZ_CACHE
+int
+__tzcache_get (int year, __tzinfo_type *tz)
+{
+  const char *tzenv = getenv ("TZ");
+  int daylight;
+
+  daylight = tz_cache_read (tzenv, year, tz);
+  if (daylight >= 0)
+    return daylight;
+
+  TZ_LOCK;
+  tzenv = getenv ("TZ");
+  _tzset_env (tzenv);
+  tz_cache_build (tzenv, year);
+  daylight = tz_cache_read (tzenv, year, tz);
+  if (daylight < 0)
+    {
+      /* TZ too long to cache */
+      *tz = *__gettzinfo ();
+      daylight = _daylight;
+    }
+  TZ_UNLOCK;
+  return daylight;
+}
+#endif
@@ -33,13 +33,21 @@
  * OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
-#include <stdio-bufio.h>
+#include "stdio_private.h"
 #include <stdlib.h>
 #include <unistd.h>
+#include <string.h>
 #include <stdbool.h>
+#include <limits.h>
 
 /* Buffered I/O routines for tiny stdio */
 
+/*
+ * Only streams opened by __fdopen_mmap have __BMAP set, so this is
+ * always present when it's needed
+ */
+void __bufio_unmap(FILE *f) __attribute__((weak));
+
 static int
 __bufio_flush_locked(FILE *f)
 {
@@ -64,6 +72,9 @@ __bufio_flush_locked(FILE *f)
 		}
                 break;
         case __SRD:
+                /* A mapping holds the whole file, keep it */
+                if (bf->bflags & __BMAP)
+                        break;
                 /* Move the FD back to the current read position */
                 backup = bf->len - bf->off;
                 if (backup) {
@@ -129,6 +140,153 @@ bail:
 	return ret;
 }
 
+/*
+ * Write a block of data. Data which fits in the buffer is copied
+ * there. Otherwise, the buffered data and the new data are sent to
+ * the device together, using writev when available
+ */
+size_t
+__bufio_write(FILE *f, const void *ptr, size_t len)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        const char *cp = ptr;
+        size_t ret = 0;
+
+	__bufio_lock(f);
+        if (__bufio_setdir_locked(f, __SWR) < 0)
+                goto bail;
+
+        if (len < (size_t) (bf->size - bf->len)) {
+                memcpy(bf->buf + bf->len, cp, len);
+                bf->len += len;
+                ret = len;
+                if ((bf->bflags & __BLBF) && memchr(cp, '\n', len))
+                        if (__bufio_flush_locked(f) < 0)
+                                ret = 0;
+                goto bail;
+        }
+
+        if (bf->writev) {
+                struct iovec iov[2];
+                struct iovec *v = iov;
+                int iovcnt = 2;
+                size_t buffered = bf->len;
+                size_t total = 0;
+
+                iov[0].iov_base = bf->buf;
+                iov[0].iov_len = buffered;
+                iov[1].iov_base = (void *) cp;
+                iov[1].iov_len = len;
+                if (!buffered) {
+                        v++;
+                        iovcnt--;
+                }
+                while (iovcnt) {
+                        ssize_t this = (bf->writev)(bf->fd, v, iovcnt);
+                        if (this <= 0)
+                                break;
+                        bf->pos += this;
+                        total += this;
+                        while (iovcnt && (size_t) this >= v->iov_len) {
+                                this -= v->iov_len;
+                                v++;
+                                iovcnt--;
+                        }
+                        if (iovcnt) {
+                                v->iov_base = (char *) v->iov_base + this;
+                                v->iov_len -= this;
+                        }
+                }
+                /* Drop buffered data on error, as __bufio_flush does */
+                bf->len = 0;
+                if (total > buffered)
+                        ret = total - buffered;
+                goto bail;
+        }
+
+        /* No writev, flush the buffer and then write the data */
+        if (__bufio_flush_locked(f) < 0)
+                goto bail;
+
+        if (len < (size_t) bf->size) {
+                memcpy(bf->buf, cp, len);
+                bf->len = len;
+                ret = len;
+                goto bail;
+        }
+
+        while (ret < len) {
+                ssize_t this = (bf->write)(bf->fd, cp + ret, len - ret);
+                if (this <= 0)
+                        break;
+                bf->pos += this;
+                ret += this;
+        }
+
+bail:
+	__bufio_unlock(f);
+	return ret;
+}
+
+/*
+ * Read more data when the buffer is empty. Reading from stdin first
+ * flushes stdout, dropping the lock to do so, in which case this
+ * returns 1 and the caller must start over
+ */
+static int
+__bufio_fill_locked(FILE *f, bool *flushed)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+
+	if (bf->off < bf->len)
+		return 0;
+
+	/* Nothing more to read past the end of a mapping */
+	if (bf->bflags & __BMAP)
+		return _FDEV_EOF;
+
+	/* Flush stdout if reading from stdin */
+	if (f == stdin && !*flushed) {
+		*flushed = true;
+		__bufio_unlock(f);
+		fflush(stdout);
+		return 1;
+	}
+
+	/* Reset read pointer, read some data */
+	bf->off = 0;
+	bf->len = (bf->read)(bf->fd, bf->buf, bf->size);
+
+	if (bf->len <= 0) {
+		bf->len = 0;
+		return _FDEV_EOF;
+	}
+
+	/* Update FD pos */
+	bf->pos += bf->len;
+	return 0;
+}
+
+/*
+ * Expose a pending ungetc char again when it matches the byte before
+ * the read position. Returns -1 when it must be read some other way
+ */
+static int
+__bufio_unget_locked(FILE *f)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        int back;
+
+        /* Past the end of a mapping, there's no byte to match */
+        if (bf->off > bf->len)
+                return __fpeek_unget(f, bf->buf, 0);
+
+        back = __fpeek_unget(f, bf->buf, bf->off);
+        if (back > 0)
+                bf->off -= back;
+        return back;
+}
+
 int
 __bufio_get(FILE *f)
 {
@@ -143,29 +301,11 @@ again:
                 goto bail;
         }
 
-	if (bf->off >= bf->len) {
-
-		/* Flush stdout if reading from stdin */
-		if (f == stdin && !flushed) {
-                        flushed = true;
-			__bufio_unlock(f);
-			fflush(stdout);
-                        goto again;
-		}
-
-		/* Reset read pointer, read some data */
-		bf->off = 0;
-		bf->len = (bf->read)(bf->fd, bf->buf, bf->size);
-
-		if (bf->len <= 0) {
-			bf->len = 0;
-                        ret = _FDEV_EOF;
-                        goto bail;
-		}
-
-                /* Update FD pos */
-                bf->pos += bf->len;
-	}
+        ret = __bufio_fill_locked(f, &flushed);
+        if (ret > 0)
+                goto again;
+        if (ret < 0)
+                goto bail;
 
 	/*
 	 * Cast to unsigned avoids sign-extending chars with high-bit
@@ -177,6 +317,127 @@ bail:
 	return ret;
 }
 
+/*
+ * Read a block of data, copying it out of the buffer and refilling
+ * that as needed. The stream stays locked throughout so that other
+ * readers can't move the buffer underneath the copy. Stops early at
+ * EOF or on error, setting the stream flags as getc does
+ */
+size_t
+__bufio_read(FILE *f, void *ptr, size_t len)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        char *cp = ptr;
+        size_t ret = 0;
+        size_t avail;
+        bool flushed = false;
+        __ungetc_t unget;
+        int err;
+
+again:
+	__bufio_lock(f);
+        if (__bufio_setdir_locked(f, __SRD) < 0) {
+                f->flags |= __SERR;
+                goto bail;
+        }
+
+        while (ret < len) {
+                /* Pending ungetc chars come before the buffer */
+                if (__bufio_unget_locked(f) < 0) {
+                        if ((unget = __atomic_exchange_ungetc(&f->unget, 0)) != 0) {
+                                __ungetc_refill(f);
+                                cp[ret++] = (char) unget;
+                        }
+                        continue;
+                }
+
+                err = __bufio_fill_locked(f, &flushed);
+                if (err > 0)
+                        goto again;
+                if (err < 0) {
+                        /* if != _FDEV_ERR, assume it's _FDEV_EOF */
+                        f->flags |= (err == _FDEV_ERR) ? __SERR : __SEOF;
+                        break;
+                }
+
+                avail = bf->len - bf->off;
+                if (avail > len - ret)
+                        avail = len - ret;
+                memcpy(cp + ret, bf->buf + bf->off, avail);
+                bf->off += avail;
+                ret += avail;
+        }
+bail:
+	__bufio_unlock(f);
+	return ret;
+}
+
+ssize_t
+__bufio_peek(FILE *f, const char **bufp)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        ssize_t ret;
+        bool flushed = false;
+
+again:
+	__bufio_lock(f);
+        if (__bufio_setdir_locked(f, __SRD) < 0) {
+                ret = _FDEV_ERR;
+                goto bail;
+        }
+
+        if (__bufio_unget_locked(f) < 0) {
+                ret = 0;
+                goto bail;
+        }
+
+        ret = __bufio_fill_locked(f, &flushed);
+        if (ret > 0)
+                goto again;
+        if (ret < 0)
+                goto bail;
+
+        *bufp = bf->buf + bf->off;
+        ret = bf->len - bf->off;
+bail:
+	__bufio_unlock(f);
+	return ret;
+}
+
+void
+__bufio_consume(FILE *f, size_t len)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+
+	__bufio_lock(f);
+        if (bf->dir == __SRD && bf->off <= bf->len &&
+            len <= (size_t) (bf->len - bf->off))
+                bf->off += len;
+	__bufio_unlock(f);
+}
+
+/*
+ * Push back 'c' by moving the read position back when it matches the
+ * byte just returned from the buffer. Returns 0 on success, -1 when
+ * the caller must stash the char elsewhere
+ */
+int
+__bufio_ungetc(FILE *f, int c)
+{
+	struct __file_bufio *bf = (struct __file_bufio *) f;
+        int ret = -1;
+
+	__bufio_lock(f);
+        if (bf->dir == __SRD && bf->off > 0 && bf->off <= bf->len &&
+            (unsigned char) bf->buf[bf->off - 1] == (unsigned char) c)
+        {
+                bf->off--;
+                ret = 0;
+        }
+	__bufio_unlock(f);
+	return ret;
+}
+
 off_t
 __bufio_seek(FILE *f, off_t offset, int whence)
 {
@@ -186,6 +447,26 @@ __bufio_seek(FILE *f, off_t offset, int whence)
 	__bufio_lock(f);
         if (__bufio_setdir_locked(f, 0) < 0)
                 return _FDEV_ERR;
+        if (bf->bflags & __BMAP) {
+                /*
+                 * Move within the mapping. Positions past the end are
+                 * kept as they are and reads from there return EOF
+                 */
+                if (whence == SEEK_CUR)
+                        offset += bf->off;
+                else if (whence == SEEK_END)
+                        offset += bf->len;
+                else if (whence != SEEK_SET)
+                        offset = -1;
+                if (offset < 0 || offset > INT_MAX) {
+                        ret = _FDEV_ERR;
+                } else {
+                        bf->off = offset;
+                        ret = offset;
+                }
+                __bufio_unlock(f);
+                return ret;
+        }
         if (bf->lseek) {
                 if (whence == SEEK_CUR) {
                         whence = SEEK_SET;
@@ -222,6 +503,9 @@ __bufio_setvbuf(FILE *f, char *buf, int mode, size_t size)
                 ret = -1;
                 goto bail;
         }
+        /* Reads come straight from the mapping, there's no buffer to replace */
+        if (bf->bflags & __BMAP)
+                goto bail;
         if (bf->bflags & __BALL) {
                 /*
                  * Handling allocation failures here is a bit tricky;
@@ -265,6 +549,8 @@ __bufio_close(FILE *f)
 
         if (bf->bflags & __BALL)
                 free(bf->buf);
+        else if (bf->bflags & __BMAP)
+                __bufio_unmap(f);
 
 	__bufio_lock_close(f);
 	/* Don't close stdin/stdout/stderr fds */
@@ -35,6 +35,7 @@
 
 #include "stdio_private.h"
 #include <stdlib.h>
+#include <string.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -50,6 +51,13 @@ fdopen(int fd, const char *mode)
 	if (stdio_flags == 0)
 		return NULL;
 
+        /* Read-only streams with 'm' in the mode read from a mapping of the file */
+        if (stdio_flags == __SRD && strchr(mode, 'm')) {
+                FILE *f = __fdopen_mmap(fd);
+                if (f)
+                        return f;
+        }
+
 	/* Allocate file structure and necessary buffers */
 	bf = calloc(1, sizeof(struct __file_bufio) + BUFSIZ);
 
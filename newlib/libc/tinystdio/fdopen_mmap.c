@@ -0,0 +1,111 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "stdio_private.h"
+#include <stdlib.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/*
+ * Read-only streams backed by a memory mapping of the whole
+ * file. These are regular bufio streams with __BMAP set, where the
+ * buffer is the mapping, so there's no buffer to fill and no read
+ * calls after the file is opened.
+ *
+ * mmap and munmap are referenced weakly so that targets without them
+ * (semihosting, most embedded systems) still link, in which case
+ * fdopen falls back to a regular buffered stream.
+ */
+
+void *mmap(void *addr, size_t len, int prot, int flags, int fd, off_t offset) __attribute__((weak));
+int munmap(void *addr, size_t len) __attribute__((weak));
+
+/* Release the mapping, called with the stream locked */
+void
+__bufio_unmap(FILE *f)
+{
+        struct __file_bufio *bf = (struct __file_bufio *) f;
+
+        munmap(bf->buf, (size_t) bf->size);
+        bf->buf = NULL;
+        bf->size = 0;
+        bf->len = 0;
+        bf->off = 0;
+        bf->bflags &= ~__BMAP;
+}
+
+FILE *
+__fdopen_mmap(int fd)
+{
+        struct __file_bufio *bf;
+        off_t   cur, end;
+        void    *buf;
+
+        if (!mmap || !munmap)
+                return NULL;
+
+        cur = lseek(fd, 0, SEEK_CUR);
+        if (cur < 0)
+                return NULL;
+        end = lseek(fd, 0, SEEK_END);
+        if (end < 0)
+                return NULL;
+        (void) lseek(fd, cur, SEEK_SET);
+
+        /* Empty or huge files get a regular stream */
+        if (end == 0 || end > INT_MAX || cur > end)
+                return NULL;
+
+        bf = calloc(1, sizeof(struct __file_bufio));
+        if (bf == NULL)
+                return NULL;
+
+        buf = mmap(NULL, (size_t) end, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (buf == MAP_FAILED) {
+                free(bf);
+                return NULL;
+        }
+
+        *bf = (struct __file_bufio)
+                FDEV_SETUP_POSIX(fd, buf, (int) end, __SRD, __BMAP);
+        bf->dir = __SRD;
+        bf->len = (int) end;
+        bf->off = (int) cur;
+
+        __bufio_lock_init(&(bf->xfile.cfile.file));
+
+        return &(bf->xfile.cfile.file);
+}
@@ -42,8 +42,10 @@ fgetc(FILE *stream)
 	if ((stream->flags & __SRD) == 0)
 		return EOF;
 
-	if ((unget = __atomic_exchange_ungetc(&stream->unget, 0)) != 0)
+	if ((unget = __atomic_exchange_ungetc(&stream->unget, 0)) != 0) {
+		__ungetc_refill(stream);
 		return (unsigned char) unget;
+	}
 
 	rv = stream->get(stream);
 	if (rv < 0) {
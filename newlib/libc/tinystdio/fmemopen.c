@@ -35,6 +35,7 @@
 
 #include "stdio_private.h"
 #include <stdlib.h>
+#include <string.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -71,6 +72,36 @@ static int __fmem_get(FILE *f)
         return c;
 }
 
+static ssize_t __fmem_peek(FILE *f, const char **bufp)
+{
+        struct __file_mem *mf = (struct __file_mem *) f;
+        const char *end;
+        int back;
+
+        back = __fpeek_unget(f, mf->buf, mf->pos);
+        if (back < 0)
+                return 0;
+        mf->pos -= back;
+        if (mf->pos >= mf->size)
+                return _FDEV_EOF;
+        /* Reading stops at a null byte, just like __fmem_get */
+        end = memchr(mf->buf + mf->pos, '\0', mf->size - mf->pos);
+        if (!end)
+                end = mf->buf + mf->size;
+        if (end == mf->buf + mf->pos)
+                return _FDEV_EOF;
+        *bufp = mf->buf + mf->pos;
+        return end - *bufp;
+}
+
+static void __fmem_consume(FILE *f, size_t len)
+{
+        struct __file_mem *mf = (struct __file_mem *) f;
+
+        if (len <= mf->size - mf->pos)
+                mf->pos += len;
+}
+
 static int __fmem_flush(FILE *f)
 {
         struct __file_mem *mf = (struct __file_mem *) f;
@@ -139,8 +170,9 @@ fmemopen(void *buf, size_t size, const char *mode)
         }
 
         *mf = (struct __file_mem) {
-                .xfile = FDEV_SETUP_EXT(__fmem_put, __fmem_get, __fmem_flush, __fmem_close,
-                                        __fmem_seek, NULL, stdio_flags),
+                .xfile = FDEV_SETUP_EXT_PEEK(__fmem_put, __fmem_get, __fmem_flush, __fmem_close,
+                                             __fmem_seek, NULL, __fmem_peek, __fmem_consume,
+                                             stdio_flags),
                 .buf = buf,
                 .size = size,
                 .pos = 0,
@@ -0,0 +1,79 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "stdio_private.h"
+#include <string.h>
+
+static ssize_t
+__file_str_peek(FILE *stream, const char **bufp)
+{
+	struct __file_str *sstream = (struct __file_str *) stream;
+
+        /* There's no way to back up over a pending ungetc here */
+        if (stream->unget)
+                return 0;
+
+        /* Find the end of the string the first time through */
+        if (sstream->end < sstream->pos)
+                sstream->end = sstream->pos + strlen(sstream->pos);
+        if (sstream->end == sstream->pos)
+                return _FDEV_EOF;
+        *bufp = sstream->pos;
+        return sstream->end - sstream->pos;
+}
+
+const char *
+__fpeek(FILE *stream, size_t *avail)
+{
+        struct __file_ext *xf = (struct __file_ext *) stream;
+        const char *buf = NULL;
+        ssize_t len = 0;
+
+        if (stream->flags & __SRD) {
+                if ((stream->flags & __SEXT) && xf->peek)
+                        len = (xf->peek)(stream, &buf);
+                else if (stream->get == __file_str_get)
+                        len = __file_str_peek(stream, &buf);
+        }
+        if (len <= 0) {
+                if (len < 0)
+                        /* if != _FDEV_ERR, assume it's _FDEV_EOF */
+                        stream->flags |= (len == _FDEV_ERR)? __SERR: __SEOF;
+                *avail = 0;
+                return NULL;
+        }
+        *avail = len;
+        return buf;
+}
@@ -30,8 +30,50 @@
 /* $Id: fread.c 1944 2009-04-01 23:12:20Z arcanum $ */
 
 #include <stdio.h>
+#include <string.h>
 #include "stdio_private.h"
 
+/* Weak, like __bufio_write in fwrite.c */
+size_t __bufio_read(FILE *f, void *ptr, size_t len) __attribute__((weak));
+
+/*
+ * Copy len bytes out of a stream which exposes its buffer through
+ * peek, falling back to getc for chars pending from ungetc. The
+ * buffer isn't locked between the peek and the consume, so this is
+ * only used for streams without a lock, like those from fmemopen;
+ * bufio streams go through __bufio_read instead
+ */
+static size_t
+fread_peek(uint8_t *cp, size_t len, FILE *stream)
+{
+	struct __file_ext *xf = (struct __file_ext *) stream;
+	size_t done = 0;
+	const char *buf;
+	ssize_t avail;
+	int c;
+
+	while (done < len) {
+		avail = (xf->peek)(stream, &buf);
+		if (avail > 0) {
+			if ((size_t) avail > len - done)
+				avail = len - done;
+			memcpy(cp + done, buf, avail);
+			(xf->consume)(stream, avail);
+			done += avail;
+		} else if (avail < 0) {
+			/* if != _FDEV_ERR, assume it's _FDEV_EOF */
+			stream->flags |= (avail == _FDEV_ERR)? __SERR: __SEOF;
+			break;
+		} else {
+			c = getc(stream);
+			if (c == EOF)
+				break;
+			cp[done++] = (uint8_t)c;
+		}
+	}
+	return done;
+}
+
 size_t
 fread(void *ptr, size_t size, size_t nmemb, FILE *stream)
 {
@@ -42,6 +84,13 @@ fread(void *ptr, size_t size, size_t nmemb, FILE *stream)
 	if ((stream->flags & __SRD) == 0 || size == 0)
 		return 0;
 
+	if ((stream->flags & __SBUF) && __bufio_read && nmemb <= SIZE_MAX / size)
+		return __bufio_read(stream, ptr, size * nmemb) / size;
+
+	if ((stream->flags & __SEXT) && ((struct __file_ext *) stream)->peek &&
+	    nmemb <= SIZE_MAX / size)
+		return fread_peek(ptr, size * nmemb, stream) / size;
+
 	for (i = 0, cp = (uint8_t *)ptr; i < nmemb; i++)
 		for (j = 0; j < size; j++) {
 			c = getc(stream);
@@ -38,6 +38,9 @@
 #include <fcntl.h>
 #include <unistd.h>
 
+/* Only present when __fdopen_mmap can create __BMAP streams */
+void __bufio_unmap(FILE *f) __attribute__((weak));
+
 FILE *
 freopen(const char *pathname, const char *mode, FILE *stream)
 {
@@ -45,6 +48,7 @@ freopen(const char *pathname, const char *mode, FILE *stream)
 	int fd;
 	int stdio_flags;
 	int open_flags;
+        char *buf = NULL;
 
         /* Can't reopen FILEs which aren't buffered */
         if (!(stream->flags & __SBUF))
@@ -58,9 +62,24 @@ freopen(const char *pathname, const char *mode, FILE *stream)
 	if (fd < 0)
 		return NULL;
 
+        /* Streams reading from a mapping need a real buffer now */
+        if (pf->bflags & __BMAP) {
+                buf = malloc(BUFSIZ);
+                if (!buf) {
+                        close(fd);
+                        return NULL;
+                }
+        }
+
         fflush(stream);
 
         __bufio_lock(stream);
+        if (buf) {
+                __bufio_unmap(stream);
+                pf->buf = buf;
+                pf->size = BUFSIZ;
+                pf->bflags |= __BALL;
+        }
         close(pf->fd);
         stream->flags = (stream->flags & ~(__SRD|__SWR|__SERR|__SEOF)) | stdio_flags;
         pf->pos = 0;
@@ -69,6 +88,7 @@ freopen(const char *pathname, const char *mode, FILE *stream)
         /* Switch to POSIX backend */
         pf->read = read;
         pf->write = write;
+        pf->writev = NULL;
         pf->lseek = lseek;
         pf->close = close;
 
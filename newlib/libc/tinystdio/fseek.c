@@ -46,7 +46,7 @@ int fseek(FILE *stream, FSEEK_TYPE offset, int whence)
         if ((stream->flags & __SEXT) && xf->seek) {
                 if ((xf->seek) (stream, (__off_t) offset, whence) >= 0) {
                         stream->flags &= ~__SEOF;
-                        (void) __atomic_exchange_ungetc(&stream->unget, 0);
+                        __ungetc_discard(stream);
                         return 0;
                 }
                 return -1;
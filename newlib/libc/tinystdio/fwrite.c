@@ -30,8 +30,15 @@
 /* $Id: fwrite.c 1944 2009-04-01 23:12:20Z arcanum $ */
 
 #include <stdio.h>
+#include <stdint.h>
 #include "stdio_private.h"
 
+/*
+ * Don't drag in the bufio code unless some bufio stream is in use,
+ * which is the only way for __SBUF to be set
+ */
+size_t __bufio_write(FILE *f, const void *ptr, size_t len) __attribute__((weak));
+
 size_t
 fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream)
 {
@@ -41,6 +48,9 @@ fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream)
 	if ((stream->flags & __SWR) == 0 || size == 0)
 		return 0;
 
+	if ((stream->flags & __SBUF) && __bufio_write && nmemb <= SIZE_MAX / size)
+		return __bufio_write(stream, ptr, size * nmemb) / size;
+
 	for (i = 0, cp = (const uint8_t *)ptr; i < nmemb; i++)
 		for (j = 0; j < size; j++)
 			if (stream->put(*cp++, stream) < 0)
@@ -50,6 +50,10 @@ snprintf(char *s, size_t n, const char *fmt, ...)
 
 	struct __file_str f = FDEV_SETUP_STRING_WRITE(s, n ? n - 1 : 0);
 
+	/* Just compute the length when there's no space for output */
+	if (n == 0)
+		f.file.put = __file_null_put;
+
 	va_start(ap, fmt);
 	i = vfprintf(&f.file, fmt, ap);
 	va_end(ap);
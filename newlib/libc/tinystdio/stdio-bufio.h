@@ -38,10 +38,12 @@
 
 #include <stdio.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/lock.h>
 
 #define __BALL  0x0001          /* bufio buf is allocated by stdio */
 #define __BLBF  0x0002          /* bufio is line buffered */
+#define __BMAP  0x0004          /* bufio buf is a read-only mapping of the whole file */
 
 struct __file_bufio {
         struct __file_ext xfile;
@@ -55,6 +57,7 @@ struct __file_bufio {
 	int	off;    /* offset of data in buf */
         ssize_t (*read)(int fd, void *buf, size_t count);
         ssize_t (*write)(int fd, const void *buf, size_t count);
+        ssize_t (*writev)(int fd, const struct iovec *iov, int iovcnt); /* optional */
         __off_t (*lseek)(int fd, __off_t offset, int whence);
         int     (*close)(int fd);
 #ifndef __SINGLE_THREAD__
@@ -62,12 +65,18 @@ struct __file_bufio {
 #endif
 };
 
-#define FDEV_SETUP_BUFIO(_fd, _buf, _size, _read, _write, _lseek, _close, _rwflag, _bflags) \
+/*
+ * The writev function is optional. When present, fwrite uses it to
+ * send the buffered data along with the caller's data in a single
+ * call instead of flushing the buffer first
+ */
+#define FDEV_SETUP_BUFIO_WRITEV(_fd, _buf, _size, _read, _write, _writev, _lseek, _close, _rwflag, _bflags) \
         {                                                               \
-                .xfile = FDEV_SETUP_EXT(__bufio_put, __bufio_get,       \
-                                        __bufio_flush, __bufio_close,   \
-                                        __bufio_seek, __bufio_setvbuf,  \
-                                        (_rwflag) | __SBUF),            \
+                .xfile = FDEV_SETUP_EXT_PEEK(__bufio_put, __bufio_get,  \
+                                             __bufio_flush, __bufio_close, \
+                                             __bufio_seek, __bufio_setvbuf, \
+                                             __bufio_peek, __bufio_consume, \
+                                             (_rwflag) | __SBUF),       \
                 .fd = _fd,                                              \
                 .dir = 0,                                               \
                 .bflags = (_bflags),                                    \
@@ -78,10 +87,15 @@ struct __file_bufio {
                 .off = 0,                                               \
                 .read = _read,                                          \
                 .write = _write,                                        \
+                .writev = _writev,                                      \
                 .lseek = _lseek,                                        \
                 .close = _close,                                        \
         }
 
+#define FDEV_SETUP_BUFIO(_fd, _buf, _size, _read, _write, _lseek, _close, _rwflag, _bflags) \
+        FDEV_SETUP_BUFIO_WRITEV(_fd, _buf, _size, _read, _write, NULL,  \
+                                _lseek, _close, _rwflag, _bflags)
+
 static inline void __bufio_lock_init(FILE *f) {
 	(void) f;
 	__lock_init(((struct __file_bufio *) f)->lock);
@@ -109,9 +123,24 @@ __bufio_flush(FILE *f);
 int
 __bufio_put(char c, FILE *f);
 
+size_t
+__bufio_write(FILE *f, const void *ptr, size_t len);
+
 int
 __bufio_get(FILE *f);
 
+size_t
+__bufio_read(FILE *f, void *ptr, size_t len);
+
+ssize_t
+__bufio_peek(FILE *f, const char **bufp);
+
+void
+__bufio_consume(FILE *f, size_t len);
+
+int
+__bufio_ungetc(FILE *f, int c);
+
 off_t
 __bufio_seek(FILE *f, off_t offset, int whence);
 
@@ -121,4 +150,7 @@ __bufio_setvbuf(FILE *f, char *buf, int mode, size_t size);
 int
 __bufio_close(FILE *f);
 
+void
+__bufio_unmap(FILE *f);
+
 #endif /* _STDIO_BUFIO_H_ */
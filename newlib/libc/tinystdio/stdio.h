@@ -247,9 +247,22 @@ typedef uint32_t __ungetc_t;
 typedef uint16_t __ungetc_t;
 #endif
 
+/*
+ * Additional pushback beyond the single ungetc() slot, enabled with
+ * the ungetc-depth build option. When unset, struct __file has no
+ * extra storage.
+ */
+#ifndef __PICOLIBC_UNGETC_DEPTH
+#define __PICOLIBC_UNGETC_DEPTH	1
+#endif
+
 struct __file {
 	__ungetc_t unget;	/* ungetc() buffer */
 	uint8_t	flags;		/* flags, see below */
+#if __PICOLIBC_UNGETC_DEPTH > 1
+	uint8_t	unget_n;	/* chars saved in unget_buf */
+	unsigned char unget_buf[__PICOLIBC_UNGETC_DEPTH - 1]; /* older ungetc() chars */
+#endif
 #define __SRD	0x0001		/* OK to read */
 #define __SWR	0x0002		/* OK to write */
 #define __SERR	0x0004		/* found error */
@@ -281,15 +294,22 @@ struct __file_ext {
         struct __file_close cfile;              /* close file struct */
         __off_t (*seek)(struct __file *, __off_t offset, int whence);
         int     (*setvbuf)(struct __file *, char *buf, int mode, size_t size);
+        __ssize_t (*peek)(struct __file *, const char **bufp); /* expose buffered data */
+        void    (*consume)(struct __file *, size_t len);        /* skip peeked data */
 };
 
-#define FDEV_SETUP_EXT(put, get, flush, close, _seek, _setvbuf, rwflag) \
+#define FDEV_SETUP_EXT_PEEK(put, get, flush, close, _seek, _setvbuf, _peek, _consume, rwflag) \
         {                                                               \
                 .cfile = FDEV_SETUP_CLOSE(put, get, flush, close, (rwflag) | __SEXT), \
                 .seek = (_seek),                                        \
                 .setvbuf = (_setvbuf),                                  \
+                .peek = (_peek),                                        \
+                .consume = (_consume),                                  \
         }
 
+#define FDEV_SETUP_EXT(put, get, flush, close, _seek, _setvbuf, rwflag) \
+        FDEV_SETUP_EXT_PEEK(put, get, flush, close, _seek, _setvbuf, NULL, NULL, rwflag)
+
 #endif /* not __DOXYGEN__ */
 
 /*@{*/
@@ -902,6 +922,25 @@ extern int	vsscanf(const char *__buf, const char *__fmt, va_list ap) __FORMAT_AT
  */
 extern int	fflush(FILE *stream);
 
+/**
+   Return a pointer to the data available for reading from \c stream
+   without copying it, storing the number of bytes in \c *avail. When
+   the stream buffer is empty, it is refilled first. The data remain
+   valid until the next operation on \c stream.
+
+   Returns NULL with \c *avail set to zero at end of file or on
+   error, setting the stream's EOF or error indicator. If neither is
+   set, the stream doesn't support peeking (or holds a character
+   pushed back by ungetc()) and should be read with getc() instead.
+ */
+extern const char *__fpeek(FILE *__stream, size_t *__avail);
+
+/**
+   Consume \c len bytes of the data returned by __fpeek(). \c len
+   must not exceed the \c *avail value returned by that call.
+ */
+extern void	__fconsume(FILE *__stream, size_t __len);
+
 #ifndef SEEK_SET
 #define	SEEK_SET	0	/* set file offset to offset */
 #endif
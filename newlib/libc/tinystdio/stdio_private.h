@@ -65,6 +65,9 @@ __file_str_put(char c, FILE *stream);
 int
 __file_str_put_alloc(char c, FILE *stream);
 
+int
+__file_null_put(char c, FILE *stream);
+
 extern const char __match_inf[];
 extern const char __match_inity[];
 extern const char __match_nan[];
@@ -119,6 +122,9 @@ bool __matchcaseprefix(const char *input, const char *pattern);
 int
 __posix_sflags (const char *mode, int *optr);
 
+FILE *
+__fdopen_mmap(int fd);
+
 #endif
 
 int	__d_vfprintf(FILE *__stream, const char *__fmt, va_list __ap) __FORMAT_ATTRIBUTE__(printf, 2, 0);
@@ -414,4 +420,53 @@ __atomic_exchange_ungetc(__ungetc_t *p, __ungetc_t v);
 
 #endif /* ATOMIC_UNGETC */
 
+/*
+ * Peeking at buffered data is only possible with no pending ungetc,
+ * or when the pushed-back character matches the byte just before the
+ * current position, which can then be exposed again. Returns the
+ * number of bytes to back up (0 or 1), or -1 when the pending
+ * character must be read with getc first
+ */
+static inline int
+__fpeek_unget(FILE *f, const char *buf, size_t pos)
+{
+	__ungetc_t unget = f->unget;
+
+	if (unget == 0)
+		return 0;
+#if __PICOLIBC_UNGETC_DEPTH > 1
+	if (f->unget_n)
+		return -1;
+#endif
+	if (pos > 0 && (unsigned char) buf[pos - 1] == (unsigned char) unget &&
+	    __atomic_compare_exchange_ungetc(&f->unget, unget, 0))
+		return 1;
+	return -1;
+}
+
+/*
+ * With ungetc-depth > 1, older pushed-back chars live in unget_buf
+ * and move into the unget slot as it is consumed. These updates are
+ * not atomic.
+ */
+static inline void
+__ungetc_refill(FILE *f)
+{
+#if __PICOLIBC_UNGETC_DEPTH > 1
+	if (f->unget_n)
+		f->unget = f->unget_buf[--f->unget_n] | UNGETC_MARK;
+#else
+	(void) f;
+#endif
+}
+
+static inline void
+__ungetc_discard(FILE *f)
+{
+#if __PICOLIBC_UNGETC_DEPTH > 1
+	f->unget_n = 0;
+#endif
+	(void) __atomic_exchange_ungetc(&f->unget, 0);
+}
+
 #endif /* _STDIO_PRIVATE_H_ */
@@ -32,21 +32,51 @@
 #include <stdio.h>
 #include "stdio_private.h"
 
+/*
+ * Don't drag in the bufio code unless some bufio stream is in use,
+ * which is the only way for __SBUF to be set
+ */
+int __bufio_ungetc(FILE *f, int c) __attribute__((weak));
+
 int
 ungetc(int c, FILE *stream)
 {
+#if __PICOLIBC_UNGETC_DEPTH > 1
+	__ungetc_t unget;
+#endif
+
 	/*
-	 * Streams that are not readable, or streams that already had
-	 * had an ungetc() before will cause an error.
+	 * Streams that are not readable, or streams whose pushback
+	 * storage is already full will cause an error.
 	 *
 	 * ungetc(EOF, ...) causes an error per definitionem.
 	 */
 	if ((stream->flags & __SRD) == 0 || c == EOF)
 		return EOF;
 
-	if (!__atomic_compare_exchange_ungetc(&stream->unget, 0, c | UNGETC_MARK))
+	/*
+	 * Buffered streams can usually just back up over the char
+	 * which was read, as long as nothing else is pending. That
+	 * allows any number of chars to be pushed back this way.
+	 */
+	if (stream->unget == 0 && (stream->flags & __SBUF) && __bufio_ungetc &&
+	    __bufio_ungetc(stream, c) == 0)
+		goto done;
+
+	if (!__atomic_compare_exchange_ungetc(&stream->unget, 0, c | UNGETC_MARK)) {
+#if __PICOLIBC_UNGETC_DEPTH > 1
+		/* Save the pending char to make room for this one */
+		unget = stream->unget;
+		if (unget == 0 || stream->unget_n >= __PICOLIBC_UNGETC_DEPTH - 1 ||
+		    !__atomic_compare_exchange_ungetc(&stream->unget, unget, c | UNGETC_MARK))
+			return EOF;
+		stream->unget_buf[stream->unget_n++] = (unsigned char) unget;
+#else
 		return EOF;
+#endif
+	}
 
+done:
         stream->flags &= ~__SEOF;
 
 	return (unsigned char) c;
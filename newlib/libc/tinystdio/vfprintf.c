@@ -378,7 +378,25 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap_orig)
 
     int stream_len = 0;
 
-#define my_putc(c, stream) do { ++stream_len; if (put(c, stream) < 0) goto fail; } while(0)
+    /*
+     * When the output is being discarded (snprintf(NULL, 0, ...)),
+     * only the length matters, so skip generating characters
+     */
+    bool counting = (put == __file_null_put);
+
+#define my_putc(c, stream) do { ++stream_len; if (!counting && put(c, stream) < 0) goto fail; } while(0)
+
+/* Output n copies of c, n may be zero or negative */
+#define my_putpad(c, n, stream) do {                                    \
+        int _n = (n);                                                   \
+        if (counting) {                                                 \
+            if (_n > 0)                                                 \
+                stream_len += _n;                                       \
+        } else {                                                        \
+            while (_n-- > 0)                                            \
+                my_putc(c, stream);                                     \
+        }                                                               \
+    } while(0)
 
     if ((stream->flags & __SWR) == 0)
 	return EOF;
@@ -724,9 +742,8 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap_orig)
 		if (width > ndigs) {
 		    width -= ndigs;
 		    if (!(flags & FL_LPAD)) {
-			do {
-			    my_putc (' ', stream);
-			} while (--width);
+			my_putpad (' ', width, stream);
+			width = 0;
 		    }
 		} else {
 		    width = 0;
@@ -830,10 +847,8 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap_orig)
 
                 /* Output before first digit	*/
                 if (!(flags & (FL_LPAD | FL_ZFILL))) {
-                    while (width) {
-                        my_putc (' ', stream);
-                        width--;
-                    }
+                    my_putpad (' ', width, stream);
+                    width = 0;
                 }
                 if (sign)
                     my_putc (sign, stream);
@@ -846,10 +861,8 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap_orig)
 #endif
 
                 if (!(flags & FL_LPAD)) {
-                    while (width) {
-                        my_putc ('0', stream);
-                        width--;
-                    }
+                    my_putpad ('0', width, stream);
+                    width = 0;
                 }
 
                 if (flags & FL_FLTFIX) {		/* 'f' format		*/
@@ -951,15 +964,17 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap_orig)
                 size = strnlen (pnt, (flags & FL_PREC) ? prec : ~0);
 
             str_lpad:
-                if (!(flags & FL_LPAD)) {
-                    while ((size_t) width > size) {
-                        my_putc (' ', stream);
-                        width--;
-                    }
+                if (!(flags & FL_LPAD) && (size_t) width > size) {
+                    my_putpad (' ', (int) (width - size), stream);
+                    width = size;
                 }
                 width -= size;
-                while (size--) {
-                    my_putc (*pnt++, stream);
+                if (counting) {
+                    stream_len += size;
+                } else {
+                    while (size--) {
+                        my_putc (*pnt++, stream);
+                    }
                 }
 
             } else {
@@ -1065,15 +1080,21 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap_orig)
                             len = width;
                         }
                     }
-                    while (len < width) {
-                        my_putc (' ', stream);
-                        len++;
+                    if (len < width) {
+                        my_putpad (' ', width - len, stream);
+                        width = len;
                     }
                 }
 
                 /* Width remaining on right after value */
                 width -= len;
 
+                /* All that remains is the value itself, len bytes long */
+                if (counting) {
+                    stream_len += len;
+                    goto tail;
+                }
+
                 /* Output leading characters */
                 if (flags & FL_ALT) {
                     my_putc ('0', stream);
@@ -1098,10 +1119,9 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap_orig)
             }
         }
 
+    tail:
 	/* Tail is possible.	*/
-	while (width-- > 0) {
-	    my_putc (' ', stream);
-	}
+	my_putpad (' ', width, stream);
     } /* for (;;) */
 
   ret:
@@ -1110,6 +1130,7 @@ int vfprintf (FILE * stream, const char *fmt, va_list ap_orig)
 #endif
     return stream_len;
 #undef my_putc
+#undef my_putpad
 #undef ap
   fail:
     stream_len = -1;
@@ -49,6 +49,10 @@ vsnprintf(char *s, size_t n, const char *fmt, va_list ap)
 
 	struct __file_str f = FDEV_SETUP_STRING_WRITE(s, n ? n - 1 : 0);
 
+	/* Just compute the length when there's no space for output */
+	if (n == 0)
+		f.file.put = __file_null_put;
+
 	i = vfprintf(&f.file, fmt, ap);
 
 	if (n)
@@ -79,6 +79,7 @@ extern void __libc_init_array(void);
  */
 
 #include <picotls.h>
+#include <picostartup.h>
 #include <stdio.h>
 #ifdef CRT0_SEMIHOST
 #include <semihost.h>
@@ -88,12 +89,82 @@ extern void __libc_init_array(void);
 #define CONSTRUCTORS 1
 #endif
 
+#ifdef __PICOLIBC_CRT_PACKED_DATA
+/* Length of the compressed .data/.tdata image stored at __data_source,
+ * or zero when the image is stored verbatim. The stream covers .data;
+ * the .tdata template which follows it stays uncompressed so that
+ * _init_tls can copy it for new threads. scripts/picolibc-pack-data
+ * patches this value in the linked ELF file. It is const so that it
+ * lands in flash rather than in the .data image it describes; __start
+ * hides its address behind an asm barrier so the compiler can't
+ * assume it is zero.
+ */
+const uint32_t __data_packed_size = 0;
+
+/* Expand the image written by picolibc-pack-data. Each token byte
+ * is either a literal run (0x00-0x7f: copy t + 1 bytes from the
+ * input) or a match (0x80-0xff: copy (t & 0x7f) + 3 bytes from
+ * earlier in the output, at the distance minus one given by the
+ * following little-endian 16-bit value). Returns the end of the
+ * output. This is not static so that test/bench-startup.c can time it.
+ */
+unsigned char *
+__data_unpack(unsigned char *dst, const unsigned char *src, const unsigned char *end);
+
+unsigned char *
+__data_unpack(unsigned char *dst, const unsigned char *src, const unsigned char *end)
+{
+	while (src < end) {
+		unsigned t = *src++;
+		if (t < 0x80) {
+			t += 1;
+			while (t--)
+				*dst++ = *src++;
+		} else {
+			const unsigned char *from = dst - (src[0] | (src[1] << 8)) - 1;
+			src += 2;
+			t = (t & 0x7f) + 3;
+			while (t--)
+				*dst++ = *from++;
+		}
+	}
+	return dst;
+}
+#endif
+
 static inline void
 __start(void)
 {
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+	/* The table lives in .bss, so hold these until it is cleared */
+	uint64_t data_time = __startup_timer();
+	uint64_t bss_time;
+#endif
+#ifdef __PICOLIBC_CRT_PACKED_DATA
+	const uint32_t *packed = &__data_packed_size;
+	__asm__("" : "+r" (packed));
+	uint32_t packed_size = *packed;
+	if (packed_size) {
+		unsigned char *end = __data_unpack((unsigned char *) __data_start,
+						   (const unsigned char *) __data_source,
+						   (const unsigned char *) __data_source + packed_size);
+		uintptr_t done = end - (unsigned char *) __data_start;
+		memcpy(end, __data_source + done, (uintptr_t) __data_size - done);
+	} else
+#endif
 	memcpy(__data_start, __data_source, (uintptr_t) __data_size);
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+	bss_time = __startup_timer();
+#endif
 	memset(__bss_start, '\0', (uintptr_t) __bss_size);
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+	__startup_record("data", NULL, data_time);
+	__startup_record("bss", NULL, bss_time);
+#endif
 #ifdef PICOLIBC_TLS
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+	__startup_mark("tls", NULL);
+#endif
 	_set_tls(__tls_base);
 #endif
 #if defined(_HAVE_INITFINI_ARRAY) && CONSTRUCTORS
@@ -107,6 +178,9 @@ __start(void)
         static char *argv[ARGV_LEN];
         int argc = 0;
 
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+	__startup_mark("cmdline", NULL);
+#endif
         argv[argc++] = "program-name";
         if (sys_semihost_get_cmdline(cmdline, sizeof(cmdline)) == 0)
         {
@@ -129,11 +203,20 @@ __start(void)
 #define argc 0
 #endif
 
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+#ifdef CRT0_EXIT
+	atexit(__startup_dump);
+#endif
+	__startup_mark("main", NULL);
+#endif
 	int ret = main(argc, argv);
 #ifdef CRT0_EXIT
 	exit(ret);
 #else
 	(void) ret;
+#ifdef __PICOLIBC_CRT_STARTUP_TIMING
+	__startup_dump();
+#endif
 	for(;;);
 #endif
 }
@@ -72,9 +72,20 @@ _start(void)
 	__asm__("adrp x1, __stack");
 	__asm__("add  x1, x1, :lo12:__stack");
 	__asm__("mov sp, x1");
+#ifdef __ARM_FEATURE_SVE
+	/* Enable FPU and SVE */
+	__asm__("mov x1, #((0x3 << 20) | (0x3 << 16))");
+	__asm__("msr cpacr_el1,x1");
+	__asm__("isb");
+	/* Use the largest supported vector length (ZCR_EL1.LEN) */
+	__asm__("mov x1, #0xf");
+	__asm__("msr S3_0_C1_C2_0,x1");
+	__asm__("isb");
+#else
 	/* Enable FPU */
 	__asm__("mov x1, #(0x3 << 20)");
 	__asm__("msr cpacr_el1,x1");
+#endif
 	/* Jump into C code */
 	__asm__("bl _cstart");
 }
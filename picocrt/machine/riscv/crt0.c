@@ -139,13 +139,19 @@ _trap(void)
          */
         __asm__("mv     a0, sp");
 
-        /* Enable FPU (just in case) */
+        /* Enable FPU and vector unit (just in case) */
 #ifdef __riscv_flen
 	__asm__("csrr	t0, mstatus\n"
                 "li	t1, 8192\n"     	// 1 << 13 = 8192
                 "or	t0, t1, t0\n"
                 "csrw	mstatus, t0\n"
                 "csrwi	fcsr, 0");
+#endif
+#ifdef __riscv_vector
+	__asm__("csrr	t0, mstatus\n"
+                "li	t1, 512\n"     	// 1 << 9 = 512
+                "or	t0, t1, t0\n"
+                "csrw	mstatus, t0");
 #endif
         __asm__("j      _ctrap");
 }
@@ -180,6 +186,12 @@ _start(void)
                 "csrw	mstatus, t0\n"
                 "csrwi	fcsr, 0");
 #endif
+#ifdef __riscv_vector
+	__asm__("csrr	t0, mstatus\n"
+                "li	t1, 512\n"     	// 1 << 9 = 512
+                "or	t0, t1, t0\n"
+                "csrw	mstatus, t0");
+#endif
 #ifdef CRT0_SEMIHOST
         __asm__("la     t0, _trap");
         __asm__("csrw   mtvec, t0");
@@ -0,0 +1,183 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/*
+ * Startup data initialization benchmark.
+ *
+ * picocrt fills .data and .tdata from the load image in flash, either
+ * by copying it or, for applications compressed with
+ * scripts/picolibc-pack-data, by expanding it. This program carries a
+ * large, repetitive initialized table like the lookup tables which
+ * dominate .data in many applications, checks that it arrived intact
+ * and then times the copy and, when packed, the expansion of the same
+ * image into a scratch buffer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "bench-timer.h"
+
+#ifndef BENCH_REPS
+#define BENCH_REPS      16
+#endif
+
+#define TABLE_SIZE      4096
+
+static uint32_t table[TABLE_SIZE] = {
+    [0 ... 1023] = 0x01020304,
+    [1024 ... 2047] = 0x00000001,
+    [2048 ... 3071] = 0xffffffff,
+    [3072 ... 4095] = 0x12345678,
+};
+
+static const char *names[] = { "alpha", "beta", "gamma", "delta" };
+
+#ifdef PICOLIBC_TLS
+static __thread uint16_t tls_table[256] = { [0 ... 255] = 0x5a5a };
+#endif
+
+extern char __data_source[], __data_start[], __data_end[];
+
+#ifdef __PICOLIBC_CRT_PACKED_DATA
+extern const uint32_t __data_packed_size;
+unsigned char *__data_unpack(unsigned char *dst, const unsigned char *src, const unsigned char *end);
+#endif
+
+static uint32_t
+expected(int i)
+{
+    static const uint32_t values[4] = { 0x01020304, 0x00000001, 0xffffffff, 0x12345678 };
+    return values[i / 1024];
+}
+
+static int
+check_data(void)
+{
+    int errors = 0;
+    int i;
+
+    for (i = 0; i < TABLE_SIZE; i++)
+        if (table[i] != expected(i)) {
+            printf("table[%d] is 0x%08lx expected 0x%08lx\n",
+                   i, (unsigned long) table[i], (unsigned long) expected(i));
+            errors++;
+            break;
+        }
+    if (strcmp(names[2], "gamma") != 0) {
+        printf("names[2] is \"%s\"\n", names[2]);
+        errors++;
+    }
+#ifdef PICOLIBC_TLS
+    for (i = 0; i < 256; i++)
+        if (tls_table[i] != 0x5a5a) {
+            printf("tls_table[%d] is 0x%04x\n", i, tls_table[i]);
+            errors++;
+            break;
+        }
+#endif
+    return errors;
+}
+
+int
+main(void)
+{
+    size_t size = __data_end - __data_start;
+    size_t flash = size;
+    size_t packed = 0;
+    size_t table_offset = (char *) table - __data_start;
+    unsigned char *scratch;
+    bench_t best, t;
+    int errors;
+    int rep;
+
+    /* Nothing has written the table yet, so it still matches the image */
+    errors = check_data();
+
+    scratch = malloc(size);
+    if (!scratch) {
+        printf("cannot allocate %zu bytes\n", size);
+        return 1;
+    }
+
+#ifdef __PICOLIBC_CRT_PACKED_DATA
+    packed = __data_packed_size;
+#endif
+
+    best = ~(bench_t) 0;
+    for (rep = 0; rep < BENCH_REPS; rep++) {
+        t = bench_now();
+        memcpy(scratch, __data_source, size);
+        t = bench_now() - t;
+        if (t < best)
+            best = t;
+    }
+    printf("copy   %10llu %s\n", best, BENCH_UNIT);
+    if (!packed && memcmp(scratch + table_offset, table, sizeof(table)) != 0) {
+        printf("copied image does not match table\n");
+        errors++;
+    }
+
+#ifdef __PICOLIBC_CRT_PACKED_DATA
+    if (packed) {
+        const unsigned char *src = (const unsigned char *) __data_source;
+        unsigned char *end = scratch;
+
+        best = ~(bench_t) 0;
+        for (rep = 0; rep < BENCH_REPS; rep++) {
+            memset(scratch, 0, size);
+            t = bench_now();
+            end = __data_unpack(scratch, src, src + packed);
+            t = bench_now() - t;
+            if (t < best)
+                best = t;
+        }
+        printf("unpack %10llu %s\n", best, BENCH_UNIT);
+
+        /* The .tdata template after the stream is copied as it is */
+        flash = packed + size - (end - scratch);
+        if (memcmp(scratch + table_offset, table, sizeof(table)) != 0) {
+            printf("unpacked image does not match table\n");
+            errors++;
+        }
+    }
+#endif
+    printf("data image %zu bytes, %zu bytes read at startup\n", size, flash);
+
+    free(scratch);
+    return errors != 0;
+}
@@ -0,0 +1,342 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * String and memory function benchmark.
+ *
+ * Each function is run across sizes from 0 to BENCH_MAX_SIZE and
+ * across source/destination alignments, reporting the mean and
+ * worst throughput over the alignments for each size. Every call is
+ * also checked against a simple reference before it is timed, so the
+ * benchmark fails when a machine-specific version gives the wrong
+ * answer.
+ *
+ * Throughput is measured with the counter from bench-timer.h; the
+ * unit is printed with the results.
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench-timer.h"
+
+#ifndef BENCH_MAX_SIZE
+#define BENCH_MAX_SIZE  (1024 * 1024)
+#endif
+
+/* Alignments swept for each pointer */
+#ifndef BENCH_ALIGN
+#define BENCH_ALIGN     16
+#endif
+
+/* Sizes up to this get every alignment pair, larger ones a diagonal */
+#ifndef BENCH_PAIR_LIMIT
+#define BENCH_PAIR_LIMIT        4096
+#endif
+
+/* Minimum bytes processed per timed sample */
+#ifndef BENCH_BYTES
+#define BENCH_BYTES     2048
+#endif
+
+#define SLACK   (2 * BENCH_ALIGN + 128)
+
+static unsigned char *buf_a, *buf_b, *buf_r;
+static size_t max_size;
+static int errors;
+
+/* Keep results live so the calls aren't discarded */
+static volatile unsigned long sink;
+
+enum bench_func {
+    B_MEMCPY, B_MEMMOVE, B_MEMSET, B_MEMCMP, B_STRLEN,
+    B_STRCHR, B_MEMCHR, B_STRCMP, B_STRSTR, B_NFUNC
+};
+
+static const char * const bench_names[B_NFUNC] = {
+    "memcpy", "memmove", "memset", "memcmp", "strlen",
+    "strchr", "memchr", "strcmp", "strstr",
+};
+
+static const char needle[] = "abcdefgh";
+#define NEEDLE_LEN      (sizeof(needle) - 1)
+
+static void
+fail(enum bench_func f, size_t n, size_t sa, size_t da)
+{
+    if (errors++ < 20)
+        printf("%s: wrong result size %lu align %lu/%lu\n",
+               bench_names[f], (unsigned long) n,
+               (unsigned long) sa, (unsigned long) da);
+}
+
+static void
+fill(unsigned char *p, size_t n, unsigned seed)
+{
+    size_t i;
+    for (i = 0; i < n; i++)
+        p[i] = (unsigned char) ('a' + (i * 7 + seed) % 23);
+}
+
+/* Set up the buffers for F at size N and check one call against a
+ * reference; the timed calls then run on the same data */
+static void
+prepare(enum bench_func f, size_t n, size_t sa, size_t da)
+{
+    unsigned char *s = buf_a + BENCH_ALIGN + sa;
+    unsigned char *d = buf_b + BENCH_ALIGN + da;
+    size_t total = n + SLACK;      /* span any call at size n touches */
+    size_t i;
+    int ok = 1;
+
+    switch (f) {
+    case B_MEMCPY:
+        fill(buf_a, total, 1);
+        fill(buf_b, total, 2);
+        memcpy(buf_r, buf_b, total);
+        memcpy(buf_r + (d - buf_b), s, n);
+        memcpy(d, s, n);
+        ok = memcmp(buf_b, buf_r, total) == 0;
+        break;
+    case B_MEMMOVE:
+        /* Overlapping move, alternating direction with alignment */
+        fill(buf_a, total, 3);
+        memcpy(buf_r, buf_a, total);
+        s = buf_a + BENCH_ALIGN + ((sa + da) & 1 ? 64 : 0) + sa;
+        d = buf_a + BENCH_ALIGN + ((sa + da) & 1 ? 0 : 64) + da;
+        for (i = 0; i < n; i++)
+            buf_b[i] = s[i];
+        for (i = 0; i < n; i++)
+            buf_r[(d - buf_a) + i] = buf_b[i];
+        memmove(d, s, n);
+        ok = memcmp(buf_a, buf_r, total) == 0;
+        break;
+    case B_MEMSET:
+        fill(buf_b, total, 4);
+        memcpy(buf_r, buf_b, total);
+        for (i = 0; i < n; i++)
+            buf_r[(d - buf_b) + i] = 0x5a;
+        memset(d, 0x5a, n);
+        ok = memcmp(buf_b, buf_r, total) == 0;
+        break;
+    case B_MEMCMP:
+        fill(s, n, 5);
+        fill(d, n, 5);
+        ok = memcmp(s, d, n) == 0;
+        if (n) {
+            d[n - 1]++;
+            ok = ok && memcmp(s, d, n) < 0 && memcmp(d, s, n) > 0;
+            d[n - 1]--;
+        }
+        break;
+    case B_STRLEN:
+        fill(s, n, 6);
+        s[n] = '\0';
+        ok = strlen((char *) s) == n;
+        break;
+    case B_STRCHR:
+    case B_MEMCHR:
+        /* 'a' + 23 never appears in the fill */
+        fill(s, n, 7);
+        s[n] = 'a' + 23;
+        s[n + 1] = '\0';
+        if (f == B_STRCHR)
+            ok = strchr((char *) s, 'a' + 23) == (char *) s + n;
+        else
+            ok = memchr(s, 'a' + 23, n + 1) == s + n;
+        break;
+    case B_STRCMP:
+        fill(s, n, 8);
+        fill(d, n, 8);
+        s[n] = d[n] = '\0';
+        ok = strcmp((char *) s, (char *) d) == 0;
+        if (n) {
+            d[n - 1] = 'z' + 1;
+            ok = ok && strcmp((char *) s, (char *) d) < 0;
+            d[n - 1] = s[n - 1];
+        }
+        break;
+    case B_STRSTR:
+        /* The fill has partial matches but the needle only at the end */
+        for (i = 0; i < n; i++)
+            s[i] = needle[i % (NEEDLE_LEN - 1)];
+        s[n] = '\0';
+        if (n >= NEEDLE_LEN) {
+            memcpy(s + n - NEEDLE_LEN, needle, NEEDLE_LEN);
+            ok = strstr((char *) s, needle) == (char *) s + n - NEEDLE_LEN;
+        } else {
+            ok = strstr((char *) s, needle) == NULL;
+        }
+        break;
+    default:
+        break;
+    }
+    if (!ok)
+        fail(f, n, sa, da);
+}
+
+static bench_t
+run(enum bench_func f, size_t n, size_t sa, size_t da, unsigned long iters)
+{
+    unsigned char *s = buf_a + BENCH_ALIGN + sa;
+    unsigned char *d = buf_b + BENCH_ALIGN + da;
+    unsigned long i;
+    bench_t start;
+
+    if (f == B_MEMMOVE) {
+        s = buf_a + BENCH_ALIGN + ((sa + da) & 1 ? 64 : 0) + sa;
+        d = buf_a + BENCH_ALIGN + ((sa + da) & 1 ? 0 : 64) + da;
+    }
+
+    start = bench_now();
+    for (i = 0; i < iters; i++) {
+        switch (f) {
+        case B_MEMCPY:  memcpy(d, s, n); break;
+        case B_MEMMOVE: memmove(d, s, n); break;
+        case B_MEMSET:  memset(d, 0x5a, n); break;
+        case B_MEMCMP:  sink += memcmp(s, d, n); break;
+        case B_STRLEN:  sink += strlen((char *) s); break;
+        case B_STRCHR:  sink += (unsigned long) strchr((char *) s, 'a' + 23); break;
+        case B_MEMCHR:  sink += (unsigned long) memchr(s, 'a' + 23, n + 1); break;
+        case B_STRCMP:  sink += strcmp((char *) s, (char *) d); break;
+        case B_STRSTR:  sink += (unsigned long) strstr((char *) s, needle); break;
+        default: break;
+        }
+        __asm__ volatile("" ::: "memory");
+    }
+    return bench_now() - start;
+}
+
+/* Print bytes per unit with two decimals, without needing float printf */
+static void
+print_rate(unsigned long long bytes, bench_t t)
+{
+    unsigned long long r;
+
+    if (t == 0) {
+        printf(" %10s", "-");
+        return;
+    }
+    r = bytes * 100 / t;
+    printf(" %7llu.%02llu", r / 100, r % 100);
+}
+
+static void
+bench_size(enum bench_func f, size_t n)
+{
+    unsigned long iters = 1 + BENCH_BYTES / (n + 1);
+    unsigned long long bytes = (unsigned long long) iters * (n ? n : 1);
+    bench_t total = 0, worst = 0, t;
+    unsigned samples = 0;
+    size_t sa, da;
+    int pairs = n <= BENCH_PAIR_LIMIT;
+    int two = f == B_MEMCPY || f == B_MEMMOVE || f == B_MEMCMP || f == B_STRCMP;
+
+    for (sa = 0; sa < BENCH_ALIGN; sa++) {
+        for (da = 0; da < BENCH_ALIGN; da++) {
+            if (!two && da != 0)
+                break;
+            /* Past the pair limit, sweep each side against alignment zero */
+            if (two && !pairs && sa != 0 && da != 0)
+                continue;
+            prepare(f, n, sa, da);
+            t = run(f, n, sa, da, iters);
+            total += t;
+            if (t > worst)
+                worst = t;
+            samples++;
+        }
+    }
+    printf("%-8s %8lu", bench_names[f], (unsigned long) n);
+    print_rate(bytes * samples, total);
+    print_rate(bytes, worst);
+    printf("\n");
+}
+
+static size_t
+next_size(size_t n)
+{
+    size_t p;
+
+    if (n < 16)
+        return n + 1;
+    /* Powers of two and their neighbours */
+    for (p = 16; p <= n; p <<= 1)
+        ;
+    if (n + 1 == p)
+        return p;
+    if ((n & (n - 1)) == 0)
+        return n + 1;
+    return p - 1;
+}
+
+int
+main(void)
+{
+    enum bench_func f;
+    size_t n;
+
+    /* Shrink the sweep to fit targets with little memory */
+    for (max_size = BENCH_MAX_SIZE; max_size >= 1024; max_size >>= 1) {
+        buf_a = malloc(max_size + SLACK);
+        buf_b = malloc(max_size + SLACK);
+        buf_r = malloc(max_size + SLACK);
+        if (buf_a && buf_b && buf_r)
+            break;
+        free(buf_a);
+        free(buf_b);
+        free(buf_r);
+        buf_a = buf_b = buf_r = NULL;
+    }
+    if (!buf_a) {
+        printf("bench-string: out of memory\n");
+        return 1;
+    }
+
+    printf("%-8s %8s %10s %10s  (bytes/%s, max size %lu)\n",
+           "func", "size", "mean", "worst", BENCH_UNIT, (unsigned long) max_size);
+    for (f = 0; f < B_NFUNC; f++)
+        for (n = 0; n <= max_size; n = next_size(n))
+            bench_size(f, n);
+
+    free(buf_a);
+    free(buf_b);
+    free(buf_r);
+    if (errors)
+        printf("bench-string: %d wrong results\n", errors);
+    return errors != 0;
+}
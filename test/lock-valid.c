@@ -45,8 +45,48 @@
 
 #define _LOCK_T intptr_t*
 
+intptr_t __lock___atexit_recursive_mutex;
+intptr_t __lock___at_quick_exit_mutex;
+intptr_t __lock___sfp_recursive_mutex;
+intptr_t __lock___locale_mutex;
+intptr_t __lock___tz_mutex;
+intptr_t __lock___env_recursive_mutex;
+intptr_t __lock___arc4random_mutex;
+intptr_t __lock___malloc_recursive_mutex;
 intptr_t __lock___libc_recursive_mutex;
 
+/*
+ * Static locks in the order they must be acquired, from sys/lock.h.
+ * Taking one while holding a lock later in the list could deadlock.
+ * Without subsystem-locks only the last one is used.
+ */
+static intptr_t * const static_locks[] = {
+        &__lock___atexit_recursive_mutex,
+        &__lock___at_quick_exit_mutex,
+        &__lock___sfp_recursive_mutex,
+        &__lock___locale_mutex,
+        &__lock___tz_mutex,
+        &__lock___env_recursive_mutex,
+        &__lock___arc4random_mutex,
+        &__lock___malloc_recursive_mutex,
+        &__lock___libc_recursive_mutex,
+};
+
+#define NUM_STATIC_LOCKS (sizeof(static_locks) / sizeof(static_locks[0]))
+
+static void lock_order(_LOCK_T lock)
+{
+        unsigned i, j;
+
+        /* Nesting a recursive lock already held is always fine */
+        if (*lock != 0)
+                return;
+        for (i = 0; i < NUM_STATIC_LOCKS; i++)
+                if (static_locks[i] == lock)
+                        for (j = i + 1; j < NUM_STATIC_LOCKS; j++)
+                                assert(*static_locks[j] == 0);
+}
+
 #define MAX_LOCKS 32
 
 static intptr_t locks[MAX_LOCKS];
@@ -83,6 +123,7 @@ void __retarget_lock_close_recursive(_LOCK_T lock)
 void __retarget_lock_acquire(_LOCK_T lock)
 {
         assert(*lock == 0);
+        lock_order(lock);
         *lock = 1;
 }
 
@@ -90,6 +131,7 @@ void __retarget_lock_acquire(_LOCK_T lock)
 void __retarget_lock_acquire_recursive(_LOCK_T lock)
 {
         assert(*lock >= 0);
+        lock_order(lock);
         ++(*lock);
 }
 
@@ -97,14 +139,18 @@ void __retarget_lock_acquire_recursive(_LOCK_T lock)
 int __retarget_lock_try_acquire(_LOCK_T lock)
 {
         assert(*lock == 0);
+        lock_order(lock);
         *lock = 1;
+        return 1;
 }
 
 /* Try acquiring recursive lock */
 int __retarget_lock_try_acquire_recursive(_LOCK_T lock)
 {
         assert(*lock >= 0);
+        lock_order(lock);
         ++(*lock);
+        return 1;
 }
 
 /* Release non-recursive lock */
@@ -122,12 +168,19 @@ void __retarget_lock_release_recursive(_LOCK_T lock)
 }
 
 #ifdef _PICO_EXIT
-#define LIBC_LOCK_EXIT_COUNT 0
+#define ATEXIT_LOCK_EXIT_COUNT 0
 #else
 /*
- * Legacy onexit handler holds libc lock while calling hooks
+ * Legacy onexit handler holds atexit lock while calling hooks
  */
-#define LIBC_LOCK_EXIT_COUNT 1
+#define ATEXIT_LOCK_EXIT_COUNT 1
+#endif
+
+/* Without subsystem-locks, atexit uses the shared libc lock */
+#ifdef __PICOLIBC_SUBSYSTEM_LOCKS
+#define ATEXIT_LOCK     (&__lock___atexit_recursive_mutex)
+#else
+#define ATEXIT_LOCK     (&__lock___libc_recursive_mutex)
 #endif
 
 static void lock_validate(int ret, void *arg)
@@ -138,7 +191,12 @@ static void lock_validate(int ret, void *arg)
         for (i = 0; i < MAX_LOCKS; i++)
                 assert(locks[i] == 0);
 
-        assert(__lock___libc_recursive_mutex == LIBC_LOCK_EXIT_COUNT);
+        for (i = 0; i < (int) NUM_STATIC_LOCKS; i++) {
+                if (static_locks[i] == ATEXIT_LOCK)
+                        assert(*static_locks[i] == ATEXIT_LOCK_EXIT_COUNT);
+                else
+                        assert(*static_locks[i] == 0);
+        }
 }
 
 __attribute__((constructor))
@@ -41,6 +41,9 @@ static int test(int serial, char *expect, char *fmt, ...) {
     char *abuf = NULL;
     va_start(ap, fmt);
     int n;
+    int zn;
+    va_list zap;
+    va_copy(zap, ap);
 #ifdef TEST_ASPRINTF
     int an;
     va_list aap;
@@ -69,6 +72,7 @@ static int test(int serial, char *expect, char *fmt, ...) {
 			    int iv2 = va_arg(ap, int);
 			    dv = va_arg(ap, double);
 			    n = snprintf(buf, 1024, fmt, iv1, iv2, printf_float(dv));
+			    zn = snprintf(NULL, 0, fmt, iv1, iv2, printf_float(dv));
 #ifdef TEST_ASPRINTF
 			    an = asprintf(&abuf, fmt, iv1, iv2, printf_float(dv));
 #endif
@@ -76,6 +80,7 @@ static int test(int serial, char *expect, char *fmt, ...) {
 			    int iv = va_arg(ap, int);
 			    dv = va_arg(ap, double);
 			    n = snprintf(buf, 1024, fmt, iv, printf_float(dv));
+			    zn = snprintf(NULL, 0, fmt, iv, printf_float(dv));
 #ifdef TEST_ASPRINTF
 			    an = asprintf(&abuf, fmt, iv, printf_float(dv));
 #endif
@@ -83,6 +88,7 @@ static int test(int serial, char *expect, char *fmt, ...) {
 	    } else {
 		    dv = va_arg(ap, double);
 		    n = snprintf(buf, 1024, fmt, printf_float(dv));
+		    zn = snprintf(NULL, 0, fmt, printf_float(dv));
 #ifdef TEST_ASPRINTF
 		    an = asprintf(&abuf, fmt, printf_float(dv));
 #endif
@@ -91,12 +97,14 @@ static int test(int serial, char *expect, char *fmt, ...) {
 #endif
     default:
 	    n = vsnprintf(buf, 1024, fmt, ap);
+	    zn = vsnprintf(NULL, 0, fmt, zap);
 #ifdef TEST_ASPRINTF
 	    an = vasprintf(&abuf, fmt, aap);
 #endif
 	    break;
     }
     va_end(ap);
+    va_end(zap);
 #ifdef TEST_ASPRINTF
     va_end(aap);
 #endif
@@ -117,6 +125,11 @@ static int test(int serial, char *expect, char *fmt, ...) {
 	free(abuf);
         return 1;
     }
+    if (zn != n) {
+        failmsg(serial, "snprintf(NULL, 0) return %d snprintf return %d", zn, n);
+	free(abuf);
+        return 1;
+    }
 #ifdef TEST_ASPRINTF
     if (an != n) {
 	failmsg(serial, "asprintf return %d sprintf return %d\n", an, n);
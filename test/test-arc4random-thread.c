@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * With arc4random-per-thread, check that each thread gets its own
+ * generator seeded from getentropy. getentropy is replaced here with
+ * one returning the same bytes every time, so separate generators
+ * produce the same stream while a shared one would carry on where the
+ * previous thread stopped.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __PICOLIBC_ARC4RANDOM_PER_THREAD
+
+/*
+ * Threads come from the host library; picolibc has no <pthread.h>,
+ * so declare just what is needed here
+ */
+typedef unsigned long pthread_t;
+extern int pthread_create(pthread_t *thread, const void *attr,
+                          void *(*start)(void *), void *arg);
+extern int pthread_join(pthread_t thread, void **retval);
+
+#define NTHREADS        2
+#define STREAM_LEN      256
+
+static volatile int entropy_calls;
+
+int
+getentropy(void *buf, size_t len)
+{
+    size_t i;
+
+    __atomic_fetch_add(&entropy_calls, 1, __ATOMIC_RELAXED);
+    for (i = 0; i < len; i++)
+        ((unsigned char *) buf)[i] = (unsigned char) (i * 29 + 7);
+    return 0;
+}
+
+static unsigned char stream[NTHREADS + 1][STREAM_LEN];
+
+static void *
+thread_main(void *arg)
+{
+    unsigned char *out = arg;
+
+    arc4random_buf(out, STREAM_LEN);
+    return NULL;
+}
+
+int
+main(void)
+{
+    pthread_t threads[NTHREADS];
+    int errors = 0;
+    int i;
+
+    /* Seed and use the main thread's generator first */
+    arc4random_buf(stream[NTHREADS], STREAM_LEN);
+
+    /* Run the threads one after the other so the check is deterministic */
+    for (i = 0; i < NTHREADS; i++) {
+        if (pthread_create(&threads[i], NULL, thread_main, stream[i]) != 0) {
+            printf("pthread_create failed\n");
+            return 1;
+        }
+        pthread_join(threads[i], NULL);
+    }
+
+    if (entropy_calls != NTHREADS + 1) {
+        printf("getentropy called %d times, expected %d\n", entropy_calls, NTHREADS + 1);
+        errors++;
+    }
+    for (i = 0; i < NTHREADS; i++) {
+        if (memcmp(stream[i], stream[NTHREADS], STREAM_LEN) != 0) {
+            printf("thread %d: stream differs from the main thread's\n", i);
+            errors++;
+        }
+    }
+    return errors;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("arc4random-per-thread not enabled\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check that arc4random_buf fills exactly the requested bytes for
+ * sizes on both sides of the point where keystream is written
+ * directly to the caller's buffer, and that the output looks random.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUF_SIZE        20000
+#define GUARD           64
+
+static unsigned char buf[BUF_SIZE + GUARD];
+static unsigned char prev[BUF_SIZE];
+
+static const size_t sizes[] = {
+    1, 3, 63, 64, 65, 983, 984, 985, 1023, 1024, 1025, 4095, 4096, 4160,
+    16384 + 1, BUF_SIZE
+};
+
+#define NSIZES  (sizeof(sizes) / sizeof(sizes[0]))
+
+int
+main(void)
+{
+    unsigned s;
+    size_t i;
+    int ret = 0;
+
+    for (s = 0; s < NSIZES; s++) {
+        size_t n = sizes[s];
+        unsigned long count[256];
+        unsigned long max = 0;
+
+        memset(buf, 0, sizeof(buf));
+        arc4random_buf(buf, n);
+        for (i = n; i < n + GUARD; i++) {
+            if (buf[i] != 0) {
+                printf("size %zu: wrote past the end\n", n);
+                ret = 1;
+                break;
+            }
+        }
+
+        if (n >= 16 && memcmp(buf, prev, 16) == 0) {
+            printf("size %zu: repeated output\n", n);
+            ret = 1;
+        }
+        memcpy(prev, buf, n);
+
+        /* Every byte value should show up about n/256 times */
+        if (n >= 4096) {
+            memset(count, 0, sizeof(count));
+            for (i = 0; i < n; i++)
+                count[buf[i]]++;
+            for (i = 0; i < 256; i++)
+                if (count[i] > max)
+                    max = count[i];
+            if (max > 2 * (n / 256) + 16) {
+                printf("size %zu: byte value seen %lu times\n", n, max);
+                ret = 1;
+            }
+        }
+    }
+    return ret;
+}
@@ -0,0 +1,160 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdio-bufio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BUF_SIZE        16
+#define MAX_CHUNK       7
+
+static char sink[256];
+static size_t sink_len;
+static int write_calls;
+static int writev_calls;
+
+/* Accept at most MAX_CHUNK bytes per call to exercise partial writes */
+static ssize_t
+test_write(int fd, const void *buf, size_t count)
+{
+    (void) fd;
+    write_calls++;
+    if (count > MAX_CHUNK)
+        count = MAX_CHUNK;
+    memcpy(sink + sink_len, buf, count);
+    sink_len += count;
+    return count;
+}
+
+static ssize_t
+test_writev(int fd, const struct iovec *iov, int iovcnt)
+{
+    ssize_t ret = 0;
+    int i;
+
+    (void) fd;
+    writev_calls++;
+    for (i = 0; i < iovcnt; i++) {
+        size_t count = iov[i].iov_len;
+        if (ret + count > MAX_CHUNK * 3)
+            count = MAX_CHUNK * 3 - ret;
+        memcpy(sink + sink_len, iov[i].iov_base, count);
+        sink_len += count;
+        ret += count;
+        if (count < iov[i].iov_len)
+            break;
+    }
+    return ret;
+}
+
+static ssize_t
+test_read(int fd, void *buf, size_t count)
+{
+    (void) fd;
+    (void) buf;
+    (void) count;
+    return 0;
+}
+
+static int
+test_close(int fd)
+{
+    (void) fd;
+    return 0;
+}
+
+static const char data[] = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+static int
+check(const char *label, FILE *f, int expect_write, int expect_writev)
+{
+    size_t len = strlen(data);
+    int ret = 0;
+
+    sink_len = 0;
+    write_calls = 0;
+    writev_calls = 0;
+
+    if (fwrite(data, 1, 5, f) != 5) {
+        printf("%s: short fwrite of 5\n", label);
+        ret++;
+    }
+    if (sink_len != 0) {
+        printf("%s: small write not buffered\n", label);
+        ret++;
+    }
+    if (fwrite(data + 5, 1, len - 5, f) != len - 5) {
+        printf("%s: short fwrite of %zu\n", label, len - 5);
+        ret++;
+    }
+    fflush(f);
+    if (sink_len != len || memcmp(sink, data, len) != 0) {
+        printf("%s: data mismatch (%zu of %zu bytes)\n", label, sink_len, len);
+        ret++;
+    }
+    if (write_calls != expect_write || writev_calls != expect_writev) {
+        printf("%s: expected %d write %d writev calls, got %d %d\n", label,
+               expect_write, expect_writev, write_calls, writev_calls);
+        ret++;
+    }
+    return ret;
+}
+
+int
+main(void)
+{
+    static char buf_v[BUF_SIZE], buf_s[BUF_SIZE];
+    static struct __file_bufio bf_v =
+        FDEV_SETUP_BUFIO_WRITEV(3, buf_v, BUF_SIZE, test_read, test_write,
+                                test_writev, NULL, test_close, __SWR, 0);
+    static struct __file_bufio bf_s =
+        FDEV_SETUP_BUFIO(3, buf_s, BUF_SIZE, test_read, test_write,
+                         NULL, test_close, __SWR, 0);
+    FILE *f_v = &bf_v.xfile.cfile.file;
+    FILE *f_s = &bf_s.xfile.cfile.file;
+    int ret = 0;
+
+    __bufio_lock_init(f_v);
+    __bufio_lock_init(f_s);
+
+    /* 62 bytes, 21 per writev call */
+    ret += check("writev", f_v, 0, 3);
+
+    /* 5 buffered bytes, then 57 bytes, 7 per write call */
+    ret += check("write", f_s, 10, 0);
+
+    return ret;
+}
@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check the multi-block ChaCha keystream used by arc4random against
+ * the one-block code it replaces, for lengths covering the 4- and
+ * 8-lane batch sizes and across the wrap of the low counter word,
+ * and check the first blocks against the published zero key test
+ * vectors.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+
+#define KEYSTREAM_ONLY
+#include "../newlib/libc/stdlib/chacha_private.h"
+
+#define MAX_BYTES       (3 * 8 * 64 + 37)
+
+/* ChaCha20, zero key and nonce, blocks 0 and 1 */
+static const u8 zero_key_stream[128] = {
+    0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90,
+    0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28,
+    0xbd, 0xd2, 0x19, 0xb8, 0xa0, 0x8d, 0xed, 0x1a,
+    0xa8, 0x36, 0xef, 0xcc, 0x8b, 0x77, 0x0d, 0xc7,
+    0xda, 0x41, 0x59, 0x7c, 0x51, 0x57, 0x48, 0x8d,
+    0x77, 0x24, 0xe0, 0x3f, 0xb8, 0xd8, 0x4a, 0x37,
+    0x6a, 0x43, 0xb8, 0xf4, 0x15, 0x18, 0xa1, 0x1c,
+    0xc3, 0x87, 0xb6, 0x69, 0xb2, 0xee, 0x65, 0x86,
+    0x9f, 0x07, 0xe7, 0xbe, 0x55, 0x51, 0x38, 0x7a,
+    0x98, 0xba, 0x97, 0x7c, 0x73, 0x2d, 0x08, 0x0d,
+    0xcb, 0x0f, 0x29, 0xa0, 0x48, 0xe3, 0x65, 0x69,
+    0x12, 0xc6, 0x53, 0x3e, 0x32, 0xee, 0x7a, 0xed,
+    0x29, 0xb7, 0x21, 0x76, 0x9c, 0xe6, 0x4e, 0x43,
+    0xd5, 0x71, 0x33, 0xb0, 0x74, 0xd8, 0x39, 0xd5,
+    0x31, 0xed, 0x1f, 0x28, 0x51, 0x0a, 0xfb, 0x45,
+    0xac, 0xe1, 0x0a, 0x1f, 0x4b, 0x79, 0x4d, 0x6f,
+};
+
+static u8 expect[MAX_BYTES];
+static u8 got[MAX_BYTES];
+
+static void
+setup(chacha_ctx *x, int zero, u32 counter)
+{
+    u8 key[32], iv[8];
+    unsigned i;
+
+    for (i = 0; i < sizeof(key); i++)
+        key[i] = zero ? 0 : (u8) (i * 13 + 5);
+    for (i = 0; i < sizeof(iv); i++)
+        iv[i] = zero ? 0 : (u8) (i * 7 + 3);
+    chacha_keysetup(x, key, 256, 0);
+    chacha_ivsetup(x, iv);
+    x->input[12] = counter;
+}
+
+static int
+compare(u32 counter, u32 bytes)
+{
+    chacha_ctx a, b;
+
+    setup(&a, 0, counter);
+    setup(&b, 0, counter);
+    memset(expect, 0, sizeof(expect));
+    memset(got, 0, sizeof(got));
+    chacha_encrypt_bytes(&a, expect, expect, bytes);
+    chacha_keystream(&b, got, bytes);
+    if (memcmp(expect, got, sizeof(got)) != 0) {
+        printf("keystream differs: counter 0x%08lx, %lu bytes\n",
+               (unsigned long) counter, (unsigned long) bytes);
+        return 1;
+    }
+    /* Partial blocks leave the counter alone only in the scalar code */
+    if (bytes % 64 == 0 && memcmp(&a, &b, sizeof(a)) != 0) {
+        printf("state differs: counter 0x%08lx, %lu bytes\n",
+               (unsigned long) counter, (unsigned long) bytes);
+        return 1;
+    }
+    return 0;
+}
+
+int
+main(void)
+{
+    static const u32 sizes[] = {
+        64, 4 * 64 - 1, 4 * 64, 4 * 64 + 1, 8 * 64 - 1, 8 * 64,
+        8 * 64 + 1, 12 * 64, 16 * 64 + 5, MAX_BYTES
+    };
+    static const u32 counters[] = {
+        0, 1, 0xfffffff0, 0xfffffffd, 0xfffffffe, 0xffffffff
+    };
+    chacha_ctx x;
+    unsigned s, c;
+    int errors = 0;
+
+    setup(&x, 1, 0);
+    chacha_keystream(&x, got, sizeof(zero_key_stream));
+    if (memcmp(got, zero_key_stream, sizeof(zero_key_stream)) != 0) {
+        printf("zero key keystream wrong\n");
+        errors++;
+    }
+
+    /* Enough blocks to go through the multi-block code */
+    setup(&x, 1, 0);
+    chacha_keystream(&x, got, MAX_BYTES);
+    if (memcmp(got, zero_key_stream, sizeof(zero_key_stream)) != 0) {
+        printf("zero key keystream wrong in long run\n");
+        errors++;
+    }
+
+    for (c = 0; c < sizeof(counters) / sizeof(counters[0]); c++)
+        for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+            errors += compare(counters[c], sizes[s]);
+
+    /* The block counter carries into input[13] */
+    setup(&x, 0, 0xfffffffe);
+    chacha_keystream(&x, got, 8 * 64);
+    if (x.input[12] != 6 || x.input[13] != 1) {
+        printf("counter after wrap is %08lx %08lx\n",
+               (unsigned long) x.input[13], (unsigned long) x.input[12]);
+        errors++;
+    }
+    return errors;
+}
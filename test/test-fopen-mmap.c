@@ -0,0 +1,181 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Read-only 'rm' streams on a system with mmap, where they read
+ * straight from a mapping of the file: fileno, bulk fread, ungetc,
+ * __fpeek, seeking, freopen and fdopen at an offset.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdio-bufio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#define TEST_FILE_NAME  "MMAP.TXT"
+#define OTHER_FILE_NAME "MMAP2.TXT"
+#define OTHER           "second file\n"
+#define LEN             3000
+
+static int errors;
+
+#define check(cond, ...) do {                   \
+        if (!(cond)) {                          \
+            printf(__VA_ARGS__);                \
+            printf(": %s\n", #cond);            \
+            errors++;                           \
+        }                                       \
+    } while (0)
+
+/* Make sure mmap is linked in, 'rm' streams only reference it weakly */
+void *(*volatile test_mmap)(void *, size_t, int, int, int, off_t) = mmap;
+
+static char contents[LEN];
+static char buf[LEN + 100];
+
+static int
+is_mapped(FILE *f)
+{
+    return (f->flags & __SBUF) && (((struct __file_bufio *) f)->bflags & __BMAP);
+}
+
+static void
+write_file(const char *name, const char *data, size_t len)
+{
+    FILE *f = fopen(name, "w");
+
+    check(f != NULL, "fopen w %s", name);
+    if (f) {
+        check(fwrite(data, 1, len, f) == len, "fwrite %s", name);
+        fclose(f);
+    }
+}
+
+int
+main(void)
+{
+    FILE *f;
+    int fd, c, i;
+
+    for (i = 0; i < LEN; i++)
+        contents[i] = (i % 61 == 60) ? '\n' : 'a' + i % 26;
+    write_file(TEST_FILE_NAME, contents, LEN);
+    write_file(OTHER_FILE_NAME, OTHER, strlen(OTHER));
+
+    f = fopen(TEST_FILE_NAME, "rm");
+    check(f != NULL, "fopen rm");
+    if (!f)
+        return 1;
+    check(is_mapped(f), "stream not mapped");
+
+    fd = fileno(f);
+    check(fd >= 0, "fileno %d", fd);
+    check(lseek(fd, 0, SEEK_END) == LEN, "fd size");
+
+    /* Bulk reads come straight from the mapping */
+    check(fread(buf, 1, 1000, f) == 1000, "fread");
+    check(memcmp(buf, contents, 1000) == 0, "fread contents");
+
+    /* fread returns the pushed back char first */
+    c = getc(f);
+    check(c == contents[1000], "getc %d", c);
+    check(ungetc(c, f) == c, "ungetc");
+    check(fread(buf, 1, 10, f) == 10, "fread after ungetc");
+    check(memcmp(buf, contents + 1000, 10) == 0, "fread after ungetc contents");
+    check(ungetc('#', f) == '#', "ungetc other");
+    check(fread(buf, 1, 5, f) == 5, "fread after ungetc other");
+    check(buf[0] == '#' && memcmp(buf + 1, contents + 1010, 4) == 0,
+          "fread after ungetc other contents");
+
+    /* __fpeek exposes the mapping itself */
+    {
+        const char *p;
+        size_t avail;
+
+        p = __fpeek(f, &avail);
+        check(p != NULL && avail == LEN - 1014 && memcmp(p, contents + 1014, avail) == 0,
+              "peek");
+        __fconsume(f, 5);
+        check(getc(f) == contents[1019], "getc after consume");
+    }
+
+    /* Seeking within the mapping and reading to the end */
+    check(fseek(f, -10, SEEK_END) == 0, "fseek end");
+    check(ftell(f) == LEN - 10, "ftell %ld", ftell(f));
+    check(fread(buf, 1, 100, f) == 10, "fread to end");
+    check(memcmp(buf, contents + LEN - 10, 10) == 0, "fread to end contents");
+    check(feof(f), "feof");
+    check(fseek(f, 200, SEEK_SET) == 0, "fseek set");
+    check(getc(f) == contents[200], "getc after fseek");
+    check(fseek(f, LEN + 50, SEEK_SET) == 0, "fseek past end");
+    check(ftell(f) == LEN + 50, "ftell past end %ld", ftell(f));
+    check(getc(f) == EOF, "getc past end");
+    check(fread(buf, 1, 10, f) == 0, "fread past end");
+    check(ftell(f) == LEN + 50, "ftell after read past end %ld", ftell(f));
+    check(fseek(f, -60, SEEK_CUR) == 0, "fseek back from past end");
+    check(getc(f) == contents[LEN - 10], "getc after fseek back");
+
+    /* freopen switches to a regular buffered stream */
+    f = freopen(OTHER_FILE_NAME, "r", f);
+    check(f != NULL, "freopen");
+    if (!f)
+        return 1;
+    check(!is_mapped(f), "freopen stream still mapped");
+    check(fgets(buf, sizeof(buf), f) == buf && strcmp(buf, OTHER) == 0,
+          "fgets after freopen");
+    check(getc(f) == EOF, "EOF after freopen");
+    fclose(f);
+
+    /* fdopen starts reading at the current fd position */
+    fd = open(TEST_FILE_NAME, O_RDONLY);
+    check(fd >= 0, "open");
+    check(lseek(fd, 100, SEEK_SET) == 100, "lseek");
+    f = fdopen(fd, "rm");
+    check(f != NULL && is_mapped(f), "fdopen rm");
+    if (f) {
+        check(getc(f) == contents[100], "getc after fdopen");
+        check(ftell(f) == 101, "ftell after fdopen");
+        fclose(f);
+    }
+
+    (void) remove(TEST_FILE_NAME);
+    (void) remove(OTHER_FILE_NAME);
+
+    return errors ? 1 : 0;
+}
@@ -51,14 +51,14 @@
 #define MESSAGE "hello, world\n"
 
 void
-check_contents(int repeats)
+check_contents(int repeats, const char *mode)
 {
     FILE *f;
     char *s;
     int r;
     int c;
 
-    f = fopen(TEST_FILE_NAME, "r");
+    f = fopen(TEST_FILE_NAME, mode);
     check(f != NULL, "fopen r");
     for (r = 0; r < repeats; r++) {
         for (s = MESSAGE; *s; s++) {
@@ -73,6 +73,55 @@ check_contents(int repeats)
     check(r == 0, "fclose r");
 }
 
+/* Read-only streams using a memory mapping (when available) */
+void
+check_mmap(void)
+{
+    FILE *f;
+    char buf[sizeof(MESSAGE)];
+    int r;
+
+    check_contents(2, "rm");
+
+    f = fopen(TEST_FILE_NAME, "rm");
+    check(f != NULL, "fopen rm");
+    r = fseek(f, 7, SEEK_SET);
+    check(r == 0, "fseek rm");
+    check(getc(f) == 'w', "getc after fseek");
+    check(ftell(f) == 8, "ftell rm");
+    r = fseek(f, -(long) (sizeof(MESSAGE) - 1), SEEK_END);
+    check(r == 0, "fseek rm end");
+    check(fgets(buf, sizeof(buf), f) == buf, "fgets rm");
+    check(getc(f) == EOF, "EOF rm");
+    r = fclose(f);
+    f = NULL;
+    check(r == 0, "fclose rm");
+}
+
+/* Push back several chars which were just read */
+void
+check_ungetc(void)
+{
+    FILE *f;
+    const char *s;
+    int r;
+
+    f = fopen(TEST_FILE_NAME, "r");
+    check(f != NULL, "fopen r ungetc");
+    for (s = MESSAGE; s < MESSAGE + 5; s++)
+        check(getc(f) == *s, "getc before ungetc");
+    while (s > MESSAGE) {
+        --s;
+        check(ungetc(*s, f) == *s, "ungetc");
+    }
+    check(ftell(f) == 0, "ftell after ungetc");
+    for (s = MESSAGE; *s; s++)
+        check(getc(f) == *s, "getc after ungetc");
+    r = fclose(f);
+    f = NULL;
+    check(r == 0, "fclose r ungetc");
+}
+
 int
 main(void)
 {
@@ -83,20 +132,23 @@ main(void)
     check(f != NULL, "fopen w");
     fputs(MESSAGE, f);
     fclose(f);
-    check_contents(1);
+    check_contents(1, "r");
 
     /* Make sure we can append contents to a file and read them back */
     f = fopen(TEST_FILE_NAME, "a");
     check(f != NULL, "fopen a");
     fputs(MESSAGE, f);
     fclose(f);
-    check_contents(2);
+    check_contents(2, "r");
+    check_mmap();
+    check_ungetc();
 
     /* Make sure we can truncate the file */
     f = fopen(TEST_FILE_NAME, "w");
     check(f != NULL, "fopen  w 2");
     fclose(f);
-    check_contents(0);
+    check_contents(0, "r");
+    check_contents(0, "rm");
 
     (void) remove(TEST_FILE_NAME);
 
@@ -0,0 +1,214 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdio.h>
+#include <stdio-bufio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stdio_private.h"
+
+#define BUF_SIZE        8
+
+static const char data[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+static size_t data_pos;
+static int read_calls;
+
+static ssize_t
+test_read(int fd, void *buf, size_t count)
+{
+    size_t avail = strlen(data) - data_pos;
+
+    (void) fd;
+    read_calls++;
+    if (count > avail)
+        count = avail;
+    memcpy(buf, data + data_pos, count);
+    data_pos += count;
+    return count;
+}
+
+static ssize_t
+test_write(int fd, const void *buf, size_t count)
+{
+    (void) fd;
+    (void) buf;
+    return count;
+}
+
+static int
+test_close(int fd)
+{
+    (void) fd;
+    return 0;
+}
+
+#define check(condition, message) do {                  \
+        if (!(condition)) {                             \
+            printf("%s: %s\n", message, #condition);    \
+            ret++;                                      \
+        }                                               \
+    } while(0)
+
+/* Read the rest of the stream with __fpeek/__fconsume, n bytes at a time */
+static int
+check_stream(const char *label, FILE *f, size_t start, size_t n)
+{
+    char result[sizeof(data)];
+    size_t len = 0;
+    size_t avail;
+    const char *buf;
+    int ret = 0;
+
+    while ((buf = __fpeek(f, &avail)) != NULL) {
+        if (avail > n)
+            avail = n;
+        memcpy(result + len, buf, avail);
+        len += avail;
+        __fconsume(f, avail);
+    }
+    check(feof(f), label);
+    check(len == strlen(data) - start, label);
+    check(memcmp(result, data + start, len) == 0, label);
+    return ret;
+}
+
+int
+main(void)
+{
+    static char rbuf[BUF_SIZE];
+    static struct __file_bufio bf =
+        FDEV_SETUP_BUFIO(3, rbuf, BUF_SIZE, test_read, test_write,
+                         NULL, test_close, __SRD, 0);
+    FILE *f = &bf.xfile.cfile.file;
+    char mem[sizeof(data)];
+    const char *buf;
+    size_t avail;
+    int ret = 0;
+
+    __bufio_lock_init(f);
+
+    /* Buffered data are exposed directly, refilling when empty */
+    buf = __fpeek(f, &avail);
+    check(buf == rbuf && avail == BUF_SIZE, "bufio peek");
+    check(read_calls == 1, "bufio refill");
+    check(getc(f) == '0', "bufio getc");
+
+    /* Pushing back the previous character just backs up */
+    check(ungetc('0', f) == '0', "bufio ungetc");
+    buf = __fpeek(f, &avail);
+    check(buf == rbuf && avail == BUF_SIZE, "bufio peek after ungetc");
+
+    /* A different character must be read with getc first */
+    __fconsume(f, 1);
+    check(ungetc('x', f) == 'x', "bufio ungetc x");
+    buf = __fpeek(f, &avail);
+    check(buf == NULL && avail == 0 && !feof(f) && !ferror(f), "bufio peek with ungetc");
+    check(getc(f) == 'x', "bufio getc x");
+
+    /* Read the rest of the stream */
+    ret += check_stream("bufio", f, 1, 3);
+
+    /* fmemopen streams expose their whole buffer */
+    memcpy(mem, data, sizeof(data));
+    f = fmemopen(mem, sizeof(data), "r");
+    check(f != NULL, "fmemopen");
+    if (f) {
+        buf = __fpeek(f, &avail);
+        check(buf == mem && avail == strlen(data), "fmemopen peek");
+        ret += check_stream("fmemopen", f, 0, 5);
+        fclose(f);
+    }
+
+    /* String streams, as used by sscanf and strtod, expose the string */
+    {
+        static struct __file_str sf = FDEV_SETUP_STRING_READ(data);
+
+        f = &sf.file;
+        buf = __fpeek(f, &avail);
+        check(buf == data && avail == strlen(data), "string peek");
+        __fconsume(f, 2);
+        check(getc(f) == '2', "string getc after consume");
+
+        /* There's no way to back up over ungetc in a string */
+        check(ungetc('2', f) == '2', "string ungetc");
+        buf = __fpeek(f, &avail);
+        check(buf == NULL && avail == 0 && !feof(f), "string peek with ungetc");
+        check(getc(f) == '2', "string getc after ungetc");
+        ret += check_stream("string", f, 3, 4);
+    }
+    {
+        int i = 0, n = 0;
+        char word[4];
+        char *end;
+
+        check(sscanf("12345 abcdef", "%d %3s%n", &i, word, &n) == 2 &&
+              i == 12345 && strcmp(word, "abc") == 0 && n == 9, "sscanf");
+        check(strtod("1.5e3xyz", &end) == 1500.0 && strcmp(end, "xyz") == 0,
+              "strtod");
+    }
+
+    /*
+     * Streams reading from a mapping of the whole file are bufio
+     * streams with __BMAP set; a static copy of the data stands in
+     * for the mapping here
+     */
+    {
+        static char map[sizeof(data)];
+        static struct __file_bufio mbf =
+            FDEV_SETUP_BUFIO(3, map, sizeof(data) - 1, test_read, test_write,
+                             NULL, test_close, __SRD, __BMAP);
+
+        memcpy(map, data, sizeof(data));
+        mbf.len = sizeof(data) - 1;
+        f = &mbf.xfile.cfile.file;
+        __bufio_lock_init(f);
+        read_calls = 0;
+
+        buf = __fpeek(f, &avail);
+        check(buf == map && avail == strlen(data), "mapped peek");
+        __fconsume(f, 4);
+        check(getc(f) == '4', "mapped getc after consume");
+        check(ungetc('4', f) == '4', "mapped ungetc");
+        buf = __fpeek(f, &avail);
+        check(buf == map + 4 && avail == strlen(data) - 4, "mapped peek after ungetc");
+        check(fseek(f, 10, SEEK_SET) == 0, "mapped fseek");
+        buf = __fpeek(f, &avail);
+        check(buf == map + 10, "mapped peek after fseek");
+        ret += check_stream("mapped", f, 10, 7);
+        check(read_calls == 0, "mapped stream read");
+    }
+
+    return ret;
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Several threads fread fixed-size records from the same buffered
+ * stream at once. Each record holds its own index, so a read which
+ * raced with another thread over the stream buffer shows up as a
+ * torn record, or as a record seen twice or not at all.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Threads come from the host library; picolibc has no <pthread.h>,
+ * so declare just what is needed here
+ */
+typedef unsigned long pthread_t;
+extern int pthread_create(pthread_t *thread, const void *attr,
+                          void *(*start)(void *), void *arg);
+extern int pthread_join(pthread_t thread, void **retval);
+
+#define TEST_FILE_NAME  "FREADTHR.TXT"
+#define NTHREADS        4
+#define NRECORDS        20000
+#define RECORD          16
+
+static FILE *f;
+static unsigned char seen[NRECORDS];
+static volatile int torn;
+
+static void *
+thread_main(void *arg)
+{
+    char rec[RECORD + 1];
+    char *end;
+    unsigned long n;
+
+    (void) arg;
+    while (fread(rec, RECORD, 1, f) == 1) {
+        rec[RECORD] = '\0';
+        n = strtoul(rec, &end, 10);
+        if (end != rec + RECORD - 1 || *end != '\n' || n >= NRECORDS) {
+            torn = 1;
+            continue;
+        }
+        __atomic_fetch_add(&seen[n], 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+int
+main(void)
+{
+    pthread_t threads[NTHREADS];
+    int errors = 0;
+    int i;
+
+    f = fopen(TEST_FILE_NAME, "w");
+    if (!f) {
+        printf("fopen w failed\n");
+        return 1;
+    }
+    for (i = 0; i < NRECORDS; i++)
+        fprintf(f, "%0*d\n", RECORD - 1, i);
+    fclose(f);
+
+    f = fopen(TEST_FILE_NAME, "r");
+    if (!f) {
+        printf("fopen r failed\n");
+        return 1;
+    }
+    /* A small buffer makes the threads refill it often */
+    setvbuf(f, NULL, _IOFBF, 100);
+
+    for (i = 0; i < NTHREADS; i++)
+        if (pthread_create(&threads[i], NULL, thread_main, NULL) != 0) {
+            printf("pthread_create failed\n");
+            return 1;
+        }
+    for (i = 0; i < NTHREADS; i++)
+        pthread_join(threads[i], NULL);
+    fclose(f);
+    (void) remove(TEST_FILE_NAME);
+
+    if (torn) {
+        printf("torn record\n");
+        errors++;
+    }
+    for (i = 0; i < NRECORDS; i++)
+        if (seen[i] != 1) {
+            printf("record %d read %d times\n", i, seen[i]);
+            errors++;
+            break;
+        }
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * getenv, setenv, unsetenv and putenv, including the cases which
+ * invalidate the getenv hash index: adding and removing entries,
+ * growing the environment and assigning a new array to environ.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern char **environ;
+
+#define NVARS   300
+
+static int errors;
+
+#define check(cond, ...) do {                   \
+        if (!(cond)) {                          \
+            printf(__VA_ARGS__);                \
+            printf(": %s\n", #cond);            \
+            errors++;                           \
+        }                                       \
+    } while (0)
+
+static char *dup_env[] = {
+    "DUP=first",
+    "OTHER=value",
+    "DUP=second",
+    NULL
+};
+
+int
+main(void)
+{
+    char name[32], value[32];
+    char **saved;
+    char *v;
+    int i;
+
+    for (i = 0; i < NVARS; i++) {
+        snprintf(name, sizeof(name), "VAR_%d", i);
+        snprintf(value, sizeof(value), "value %d", i);
+        check(setenv(name, value, 1) == 0, "setenv %s", name);
+    }
+    for (i = 0; i < NVARS; i++) {
+        snprintf(name, sizeof(name), "VAR_%d", i);
+        snprintf(value, sizeof(value), "value %d", i);
+        v = getenv(name);
+        check(v && strcmp(v, value) == 0, "getenv %s", name);
+    }
+    check(getenv("VAR_") == NULL, "prefix");
+    check(getenv("VAR_1=") == NULL, "name with =");
+    check(getenv("NOT_THERE") == NULL, "missing");
+
+    /* No rewrite, shorter value copied in place, longer value */
+    check(setenv("VAR_7", "x", 0) == 0 && strcmp(getenv("VAR_7"), "value 7") == 0,
+          "no rewrite");
+    check(setenv("VAR_7", "x", 1) == 0 && strcmp(getenv("VAR_7"), "x") == 0,
+          "shorter");
+    check(setenv("VAR_7", "a much longer value", 1) == 0 &&
+          strcmp(getenv("VAR_7"), "a much longer value") == 0, "longer");
+
+    /* Removing an entry moves the ones after it */
+    check(unsetenv("VAR_10") == 0, "unsetenv");
+    check(getenv("VAR_10") == NULL, "unset");
+    check(strcmp(getenv("VAR_11"), "value 11") == 0, "after unset");
+    check(strcmp(getenv("VAR_299"), "value 299") == 0, "last after unset");
+
+    check(putenv("PUT=it") == 0 && strcmp(getenv("PUT"), "it") == 0, "putenv");
+
+    /* A new environ array, with the first duplicate winning */
+    saved = environ;
+    environ = dup_env;
+    check(getenv("VAR_11") == NULL, "old array");
+    v = getenv("DUP");
+    check(v && strcmp(v, "first") == 0, "duplicate");
+    check(strcmp(getenv("OTHER"), "value") == 0, "new array");
+    environ = saved;
+    check(strcmp(getenv("VAR_11"), "value 11") == 0, "restored array");
+
+    for (i = 0; i < NVARS; i++) {
+        snprintf(name, sizeof(name), "VAR_%d", i);
+        unsetenv(name);
+    }
+    check(getenv("VAR_0") == NULL, "all unset");
+    check(strcmp(getenv("PUT"), "it") == 0, "remaining");
+
+    return errors ? 1 : 0;
+}
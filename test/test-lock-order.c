@@ -0,0 +1,144 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Drive the paths where libc nests its static locks: setlocale reads
+ * the environment, time functions load TZ from it, setenv and exit
+ * handlers allocate memory. lock-valid.c checks every acquisition
+ * against the order documented in sys/lock.h; this test checks that
+ * each call leaves all of the locks released.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <locale.h>
+#include <time.h>
+
+extern intptr_t __lock___atexit_recursive_mutex;
+extern intptr_t __lock___at_quick_exit_mutex;
+extern intptr_t __lock___sfp_recursive_mutex;
+extern intptr_t __lock___locale_mutex;
+extern intptr_t __lock___tz_mutex;
+extern intptr_t __lock___env_recursive_mutex;
+extern intptr_t __lock___arc4random_mutex;
+extern intptr_t __lock___malloc_recursive_mutex;
+extern intptr_t __lock___libc_recursive_mutex;
+
+static int errors;
+
+static void
+check_released(const char *what)
+{
+    if (__lock___atexit_recursive_mutex || __lock___at_quick_exit_mutex ||
+        __lock___sfp_recursive_mutex || __lock___locale_mutex ||
+        __lock___tz_mutex || __lock___env_recursive_mutex ||
+        __lock___arc4random_mutex || __lock___malloc_recursive_mutex ||
+        __lock___libc_recursive_mutex)
+    {
+        printf("%s: lock left held\n", what);
+        errors++;
+    }
+}
+
+static void
+quick_handler(void)
+{
+}
+
+static void
+exit_handler(void)
+{
+    /* Runs with the atexit lock held by the legacy exit code */
+    void *p = malloc(32);
+    free(p);
+    (void) getenv("TZ");
+    (void) arc4random();
+}
+
+int
+main(void)
+{
+    time_t t = 1000000000;
+    struct tm tm;
+    char buf[64];
+    void *p;
+
+    if (setenv("PICOLIBC_LOCK_ORDER", "1", 1) != 0 ||
+        strcmp(getenv("PICOLIBC_LOCK_ORDER"), "1") != 0)
+    {
+        printf("setenv failed\n");
+        errors++;
+    }
+    check_released("setenv");
+    unsetenv("PICOLIBC_LOCK_ORDER");
+    check_released("unsetenv");
+
+    setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+    tzset();
+    check_released("tzset");
+    localtime_r(&t, &tm);
+    check_released("localtime_r");
+    (void) mktime(&tm);
+    check_released("mktime");
+    strftime(buf, sizeof(buf), "%c %Z %z", &tm);
+    check_released("strftime");
+
+    setenv("LANG", "C", 1);
+    (void) setlocale(LC_ALL, "");
+    check_released("setlocale");
+    (void) setlocale(LC_ALL, "C");
+
+    p = malloc(100);
+    p = realloc(p, 1000);
+    free(p);
+    check_released("malloc");
+
+    (void) arc4random_uniform(10);
+    check_released("arc4random");
+
+    snprintf(buf, sizeof(buf), "%d %s", 42, "locks");
+    check_released("snprintf");
+
+    if (atexit(exit_handler) != 0 || at_quick_exit(quick_handler) != 0) {
+        printf("atexit failed\n");
+        errors++;
+    }
+    check_released("atexit");
+
+    return errors ? 1 : 0;
+}
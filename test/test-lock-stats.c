@@ -0,0 +1,192 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Check the lock-stats counters. This supplies its own lock routines
+ * whose try_acquire can be told to fail, which lock-stats records as
+ * contention, then takes the libc lock a known number of times.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <sys/lock.h>
+
+#ifdef __PICOLIBC_LOCK_STATS
+
+struct __lock {
+    intptr_t count;
+};
+
+struct __lock __lock___atexit_recursive_mutex;
+struct __lock __lock___at_quick_exit_mutex;
+struct __lock __lock___sfp_recursive_mutex;
+struct __lock __lock___locale_mutex;
+struct __lock __lock___tz_mutex;
+struct __lock __lock___env_recursive_mutex;
+struct __lock __lock___arc4random_mutex;
+struct __lock __lock___malloc_recursive_mutex;
+struct __lock __lock___libc_recursive_mutex;
+
+#define MAX_LOCKS 32
+
+static struct __lock locks[MAX_LOCKS];
+static int lock_id;
+
+/* Number of upcoming try_acquire calls which should fail */
+static int fail_tries;
+
+void __retarget_lock_init(_LOCK_T *lock)
+{
+    *lock = &locks[lock_id++ % MAX_LOCKS];
+}
+
+void __retarget_lock_init_recursive(_LOCK_T *lock)
+{
+    *lock = &locks[lock_id++ % MAX_LOCKS];
+}
+
+void __retarget_lock_close(_LOCK_T lock)
+{
+    (void) lock;
+}
+
+void __retarget_lock_close_recursive(_LOCK_T lock)
+{
+    (void) lock;
+}
+
+void __retarget_lock_acquire(_LOCK_T lock)
+{
+    lock->count++;
+}
+
+void __retarget_lock_acquire_recursive(_LOCK_T lock)
+{
+    lock->count++;
+}
+
+int __retarget_lock_try_acquire(_LOCK_T lock)
+{
+    if (fail_tries) {
+        fail_tries--;
+        return 0;
+    }
+    lock->count++;
+    return 1;
+}
+
+int __retarget_lock_try_acquire_recursive(_LOCK_T lock)
+{
+    return __retarget_lock_try_acquire(lock);
+}
+
+void __retarget_lock_release(_LOCK_T lock)
+{
+    lock->count--;
+}
+
+void __retarget_lock_release_recursive(_LOCK_T lock)
+{
+    lock->count--;
+}
+
+#define LIBC_LOCK       (&__lock___libc_recursive_mutex)
+
+static int errors;
+
+static void
+check_counts(const char *what, unsigned long acquired, unsigned long contended)
+{
+    unsigned long a, c;
+
+    if (!__lock_stats_count(LIBC_LOCK, &a, &c)) {
+        printf("%s: libc lock not tracked\n", what);
+        errors++;
+        return;
+    }
+    if (a != acquired || c != contended) {
+        printf("%s: acquired %lu contended %lu, expected %lu and %lu\n",
+               what, a, c, acquired, contended);
+        errors++;
+    }
+}
+
+int
+main(void)
+{
+    int i;
+
+    __lock_stats_reset();
+    check_counts("after reset", 0, 0);
+
+    /* Nested acquisitions count once */
+    for (i = 0; i < 10; i++) {
+        __LIBC_LOCK();
+        __LIBC_LOCK();
+        __LIBC_UNLOCK();
+        __LIBC_UNLOCK();
+    }
+    check_counts("uncontended", 10, 0);
+
+    /* Make the first try of each of the next three acquisitions fail */
+    for (i = 0; i < 3; i++) {
+        fail_tries = 1;
+        __LIBC_LOCK();
+        __LIBC_UNLOCK();
+    }
+    check_counts("contended", 13, 3);
+
+    if (__lock___libc_recursive_mutex.count != 0) {
+        printf("libc lock left held\n");
+        errors++;
+    }
+
+    __lock_stats_reset();
+    check_counts("reset", 0, 0);
+
+    return errors;
+}
+
+#else
+
+int
+main(void)
+{
+    printf("lock-stats not enabled\n");
+    return 77;
+}
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Multithreaded stress test for the futex locks in lock-futex.c.
+ * Several threads hammer malloc, stdio and arc4random at the same time,
+ * then check that nothing was corrupted. The run is repeated with
+ * 1, 2, 4 and 8 threads and the elapsed time for each is printed to
+ * show how the locks scale under contention.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/lock.h>
+#include "bench-timer.h"
+
+/*
+ * Threads come from the host library; picolibc has no <pthread.h>,
+ * so declare just what is needed here
+ */
+typedef unsigned long pthread_t;
+extern int pthread_create(pthread_t *thread, const void *attr,
+                          void *(*start)(void *), void *arg);
+extern int pthread_join(pthread_t thread, void **retval);
+
+#define MAX_THREADS     8
+#define ITERATIONS      20000
+#define SLOTS           16
+
+/* Protected by __lock___libc_recursive_mutex */
+static unsigned long counter;
+
+static int
+check_malloc(unsigned id, unsigned i, void **slots)
+{
+    unsigned s = i % SLOTS;
+    size_t len = 1 + ((i * 37 + id * 11) % 300);
+    unsigned char *p;
+
+    if (slots[s]) {
+        unsigned char *q = slots[s];
+        size_t qlen = q[0] | (q[1] << 8);
+        size_t k;
+        for (k = 2; k < qlen; k++)
+            if (q[k] != (unsigned char) (id + qlen)) {
+                printf("thread %u: malloc block corrupted\n", id);
+                return 1;
+            }
+        free(q);
+    }
+    p = malloc(len + 2);
+    if (!p) {
+        printf("thread %u: malloc failed\n", id);
+        return 1;
+    }
+    p[0] = (len + 2) & 0xff;
+    p[1] = (len + 2) >> 8;
+    memset(p + 2, (unsigned char) (id + len + 2), len);
+    slots[s] = p;
+    return 0;
+}
+
+static int
+check_stdio(unsigned id, unsigned i)
+{
+    char buf[64];
+    char expect[64];
+    unsigned a, b;
+
+    snprintf(buf, sizeof(buf), "%u:%u:%x", id, i, i * 7);
+    if (sscanf(buf, "%u:%u:", &a, &b) != 2 || a != id || b != i) {
+        printf("thread %u: snprintf/sscanf mismatch '%s'\n", id, buf);
+        return 1;
+    }
+    strcpy(expect, buf);
+    snprintf(buf, sizeof(buf), "%s", expect);
+    if (strcmp(buf, expect) != 0) {
+        printf("thread %u: snprintf mismatch\n", id);
+        return 1;
+    }
+    return 0;
+}
+
+static int
+check_arc4random(unsigned id)
+{
+    uint32_t buf[4];
+
+    memset(buf, 0, sizeof(buf));
+    arc4random_buf(buf, sizeof(buf));
+    if (buf[0] == 0 && buf[1] == 0 && buf[2] == 0 && buf[3] == 0) {
+        printf("thread %u: arc4random_buf returned zeros\n", id);
+        return 1;
+    }
+    (void) arc4random_uniform(1000);
+    return 0;
+}
+
+static void *
+worker(void *arg)
+{
+    unsigned id = (unsigned) (uintptr_t) arg;
+    void *slots[SLOTS];
+    unsigned i;
+    int ret = 0;
+
+    memset(slots, 0, sizeof(slots));
+    for (i = 0; i < ITERATIONS && !ret; i++) {
+        ret |= check_malloc(id, i, slots);
+        if ((i & 7) == 0)
+            ret |= check_stdio(id, i);
+        if ((i & 15) == 0)
+            ret |= check_arc4random(id);
+
+        /* The global lock nests */
+        __LIBC_LOCK();
+        __LIBC_LOCK();
+        counter++;
+        __LIBC_UNLOCK();
+        __LIBC_UNLOCK();
+    }
+    for (i = 0; i < SLOTS; i++)
+        free(slots[i]);
+    return (void *) (uintptr_t) ret;
+}
+
+static int
+run(unsigned nthreads)
+{
+    pthread_t threads[MAX_THREADS];
+    bench_t start, end;
+    unsigned t;
+    int ret = 0;
+
+    counter = 0;
+    start = bench_now();
+    for (t = 0; t < nthreads; t++) {
+        if (pthread_create(&threads[t], NULL, worker, (void *) (uintptr_t) t) != 0) {
+            printf("pthread_create failed\n");
+            return 1;
+        }
+    }
+    for (t = 0; t < nthreads; t++) {
+        void *result;
+        pthread_join(threads[t], &result);
+        ret |= (int) (uintptr_t) result;
+    }
+    end = bench_now();
+
+    if (counter != (unsigned long) nthreads * ITERATIONS) {
+        printf("%u threads: counter %lu expected %lu\n", nthreads,
+               counter, (unsigned long) nthreads * ITERATIONS);
+        ret = 1;
+    }
+    printf("%u threads: %10llu %ss %s\n", nthreads, end - start,
+           BENCH_UNIT, ret ? "FAIL" : "ok");
+    return ret;
+}
+
+int
+main(void)
+{
+    unsigned nthreads;
+    int ret = 0;
+
+    for (nthreads = 1; nthreads <= MAX_THREADS; nthreads *= 2)
+        ret |= run(nthreads);
+#ifdef __PICOLIBC_LOCK_STATS
+    __lock_stats_dump();
+#endif
+    return ret;
+}
@@ -0,0 +1,110 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+#include <stdint.h>
+
+/*
+ * Check memmove with overlapping buffers in both directions. Short
+ * copies and copies to a lower address may be handed to memcpy, so
+ * this also checks that the memcpy those paths reach copes with
+ * overlap, which matters for the vector versions.
+ */
+
+#define MAX_LEN         300
+#define MAX_SHIFT       70
+#define BUF_SIZE        (MAX_LEN + 2 * MAX_SHIFT + 16)
+
+static unsigned char buf[BUF_SIZE];
+static unsigned char ref[BUF_SIZE];
+
+static void
+fill(void)
+{
+    size_t i;
+
+    for (i = 0; i < BUF_SIZE; i++)
+        buf[i] = ref[i] = (unsigned char) (i * 7 + 1);
+}
+
+static void
+ref_move(size_t dst, size_t src, size_t len)
+{
+    size_t i;
+
+    if (dst < src) {
+        for (i = 0; i < len; i++)
+            ref[dst + i] = ref[src + i];
+    } else {
+        for (i = len; i > 0; i--)
+            ref[dst + i - 1] = ref[src + i - 1];
+    }
+}
+
+int
+main(void)
+{
+    size_t len, shift, align;
+    int ret = 0;
+
+    for (len = 0; len <= MAX_LEN; len++) {
+        for (shift = 0; shift <= MAX_SHIFT; shift++) {
+            for (align = 0; align < 16; align += 5) {
+                size_t lo = align;
+                size_t hi = align + shift;
+
+                fill();
+                ref_move(hi, lo, len);
+                if (memmove(buf + hi, buf + lo, len) != buf + hi ||
+                    memcmp(buf, ref, BUF_SIZE) != 0)
+                {
+                    printf("memmove up: len %zu shift %zu align %zu\n", len, shift, align);
+                    ret = 1;
+                }
+
+                fill();
+                ref_move(lo, hi, len);
+                if (memmove(buf + lo, buf + hi, len) != buf + lo ||
+                    memcmp(buf, ref, BUF_SIZE) != 0)
+                {
+                    printf("memmove down: len %zu shift %zu align %zu\n", len, shift, align);
+                    ret = 1;
+                }
+            }
+        }
+    }
+    return ret;
+}
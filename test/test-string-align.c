@@ -0,0 +1,178 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <string.h>
+#include <wchar.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+/*
+ * Check the word and vector string functions with every starting
+ * alignment. The data is placed 'gap' elements before the end of a
+ * page-aligned area so that with gap zero it ends right at a page
+ * boundary and any over-read runs off the end of the object.
+ *
+ * Where mmap is available, the area is mapped from /dev/zero and
+ * followed by an unmapped guard page so such over-reads fault instead
+ * of going unnoticed. Otherwise it falls back to a static buffer.
+ */
+
+#define PAGE    4096
+
+union area {
+    char        c[2 * PAGE];
+    wchar_t     w[2 * PAGE / sizeof(wchar_t)];
+};
+
+static union area __attribute__((aligned(PAGE))) static_area;
+
+static union area *area = &static_area;
+
+#define NC      (sizeof(area->c) / sizeof(area->c[0]))
+#define NW      (sizeof(area->w) / sizeof(area->w[0]))
+
+void *mmap(void *addr, size_t len, int prot, int flags, int fd, off_t offset) __attribute__((weak));
+int munmap(void *addr, size_t len) __attribute__((weak));
+int open(const char *path, int flags, ...) __attribute__((weak));
+int close(int fd) __attribute__((weak));
+
+static void
+map_area(void)
+{
+    char *p;
+    int fd;
+
+    if (!mmap || !munmap || !open || !close)
+        return;
+    fd = open("/dev/zero", O_RDWR);
+    if (fd < 0)
+        return;
+    p = mmap(NULL, sizeof(union area) + PAGE, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        return;
+    if (munmap(p + sizeof(union area), PAGE) != 0) {
+        munmap(p, sizeof(union area) + PAGE);
+        return;
+    }
+    area = (union area *) p;
+    printf("using guard page\n");
+}
+
+static int ret;
+
+#define check(cond, what, a, b) do {                                    \
+        if (!(cond)) {                                                  \
+            printf("%s: gap %zu len %zu\n", what, (size_t) (a), (size_t) (b)); \
+            ret++;                                                      \
+        }                                                               \
+    } while(0)
+
+static void
+check_narrow(void)
+{
+    size_t gap, len;
+
+    for (gap = 0; gap < 64; gap++) {
+        for (len = 0; len < 80; len++) {
+            char *s = area->c + NC - 1 - gap - len;
+            char *t;
+
+            memset(area->c + PAGE, 'x', PAGE);
+            memset(s, 'a', len);
+            s[len] = '\0';
+            check(strlen(s) == len, "strlen", gap, len);
+            check(memchr(s, '\0', len + 1) == s + len, "memchr", gap, len);
+            check(memchr(s, 'b', len) == NULL, "memchr none", gap, len);
+            check(strchr(s, '\0') == s + len, "strchr nul", gap, len);
+            check(strchr(s, 'b') == NULL, "strchr none", gap, len);
+            if (len) {
+                s[len - 1] = 'b';
+                t = memchr(s, 'b', len);
+                check(t == s + len - 1, "memchr last", gap, len);
+                check(strchr(s, 'b') == s + len - 1, "strchr last", gap, len);
+            }
+        }
+    }
+}
+
+static void
+check_wide(void)
+{
+    size_t gap, len;
+
+    for (gap = 0; gap < 16; gap++) {
+        for (len = 0; len < 40; len++) {
+            wchar_t *s = area->w + NW - 1 - gap - len;
+            wchar_t other[41];
+
+            wmemset(area->w + NW / 2, L'x', NW / 2);
+            check(wmemset(s, L'a', len) == s, "wmemset", gap, len);
+            check(s[-1] == L'x' && s[len] == L'x', "wmemset bounds", gap, len);
+            s[len] = L'\0';
+            check(wcslen(s) == len, "wcslen", gap, len);
+            check(wmemchr(s, L'\0', len + 1) == s + len, "wmemchr", gap, len);
+            check(wmemchr(s, L'b', len) == NULL, "wmemchr none", gap, len);
+            check(wmemchr(s, L'\0', SIZE_MAX) == s + len, "wmemchr unbounded", gap, len);
+            check(wcschr(s, L'\0') == s + len, "wcschr nul", gap, len);
+            check(wcschr(s, L'b') == NULL, "wcschr none", gap, len);
+
+            wmemset(other, L'a', len);
+            other[len] = L'\0';
+            check(wcscmp(s, other) == 0, "wcscmp equal", gap, len);
+            if (len) {
+                s[len - 1] = L'b';
+                check(wmemchr(s, L'b', len) == s + len - 1, "wmemchr last", gap, len);
+                check(wcschr(s, L'b') == s + len - 1, "wcschr last", gap, len);
+                check(wcscmp(s, other) > 0, "wcscmp greater", gap, len);
+                check(wcscmp(other, s) < 0, "wcscmp less", gap, len);
+            }
+            if (len > 1)
+                check(wcscmp(other + 1, s + 1) < 0, "wcscmp offset", gap, len);
+        }
+    }
+}
+
+int
+main(void)
+{
+    map_area();
+    check_narrow();
+    check_wide();
+    return ret;
+}
@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _DEFAULT_SOURCE
+#include <string.h>
+#include <wchar.h>
+#include <stdio.h>
+
+static int ret;
+
+#define check(cond) do {                                        \
+        if (!(cond)) {                                          \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond);   \
+            ret++;                                              \
+        }                                                       \
+    } while(0)
+
+static void
+check_span(void)
+{
+    const char *s = "  \t\xff\x80xyz, abc";
+
+    check(strspn(s, " \t") == 3);
+    check(strspn(s, " \t\xff\x80") == 5);
+    check(strspn(s, "") == 0);
+    check(strspn("", " ") == 0);
+    check(strcspn(s, "x") == 5);
+    check(strcspn(s, "\x80,") == 4);
+    check(strcspn(s, "q") == strlen(s));
+    check(strcspn(s, "") == strlen(s));
+    check(strpbrk(s, "cb") == s + 11);
+    check(strpbrk(s, ",") == s + 8);
+    check(strpbrk(s, "\xff") == s + 3);
+    check(strpbrk(s, "q") == NULL);
+    check(strpbrk(s, "") == NULL);
+}
+
+static void
+check_tok(void)
+{
+    char buf[] = ",,a,b;;c,";
+    char *last, *t, *p;
+
+    t = strtok_r(buf, ",;", &last);
+    check(t && !strcmp(t, "a"));
+    t = strtok_r(NULL, ",;", &last);
+    check(t && !strcmp(t, "b"));
+    t = strtok_r(NULL, ",;", &last);
+    check(t && !strcmp(t, "c"));
+    t = strtok_r(NULL, ",;", &last);
+    check(t == NULL);
+
+    char buf2[] = "a,,b";
+    p = buf2;
+    t = strsep(&p, ",");
+    check(t && !strcmp(t, "a"));
+    t = strsep(&p, ",");
+    check(t && !strcmp(t, ""));
+    t = strsep(&p, ",");
+    check(t && !strcmp(t, "b") && p == NULL);
+    t = strsep(&p, ",");
+    check(t == NULL);
+}
+
+static void
+check_wide(void)
+{
+    const wchar_t *s = L"ab\x263a\x263b" L"cd";
+    wchar_t buf[] = L"\x2022x\x2022\x2022y z";
+    wchar_t *last, *t;
+
+    check(wcsspn(s, L"ba") == 2);
+    check(wcsspn(s, L"ab\x263a") == 3);
+    check(wcscspn(s, L"\x263b") == 3);
+    check(wcscspn(s, L"q\x4242") == wcslen(s));
+    check(wcspbrk(s, L"dc") == s + 4);
+    check(wcspbrk(s, L"\x263a") == s + 2);
+    check(wcspbrk(s, L"\x63a") == NULL);
+
+    t = wcstok(buf, L"\x2022 ", &last);
+    check(t && !wcscmp(t, L"x"));
+    t = wcstok(NULL, L"\x2022 ", &last);
+    check(t && !wcscmp(t, L"y"));
+    t = wcstok(NULL, L"\x2022 ", &last);
+    check(t && !wcscmp(t, L"z"));
+    t = wcstok(NULL, L"\x2022 ", &last);
+    check(t == NULL);
+}
+
+int
+main(void)
+{
+    check_span();
+    check_tok();
+    check_wide();
+    return ret;
+}
@@ -0,0 +1,148 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Compare strstr, memmem and strcasestr against simple reference
+ * versions across needle lengths on both sides of the short needle
+ * limit, with matches placed at every offset.
+ */
+
+#define HS_LEN  80
+#define LONG_LEN        3000
+
+static int ret;
+
+static const char *
+ref_search(const char *hs, size_t hs_len, const char *ne, size_t ne_len, int fold)
+{
+    size_t i, j;
+
+    for (i = 0; i + ne_len <= hs_len; i++) {
+        for (j = 0; j < ne_len; j++) {
+            int a = (unsigned char) hs[i + j], b = (unsigned char) ne[j];
+            if (fold) {
+                a = tolower(a);
+                b = tolower(b);
+            }
+            if (a != b)
+                break;
+        }
+        if (j == ne_len)
+            return hs + i;
+    }
+    return NULL;
+}
+
+#define check(name, got, expect) do {                                   \
+        if ((got) != (expect)) {                                        \
+            printf("%s: hs \"%s\" ne \"%s\" got %ld expect %ld\n",      \
+                   name, hs, ne,                                        \
+                   (got) ? (long) ((const char *) (got) - hs) : -1L,    \
+                   (expect) ? (long) ((const char *) (expect) - hs) : -1L); \
+            ret++;                                                      \
+        }                                                               \
+    } while(0)
+
+static void
+check_one(const char *hs, const char *ne)
+{
+    size_t hs_len = strlen(hs), ne_len = strlen(ne);
+
+    check("strstr", strstr(hs, ne), ref_search(hs, hs_len, ne, ne_len, 0));
+    check("memmem", memmem(hs, hs_len, ne, ne_len), ref_search(hs, hs_len, ne, ne_len, 0));
+    check("strcasestr", strcasestr(hs, ne), ref_search(hs, hs_len, ne, ne_len, 1));
+}
+
+int
+main(void)
+{
+    static const char alpha[] = "abAB";
+    char hs[HS_LEN + 1];
+    char ne[HS_LEN + 1];
+    size_t ne_len, pos, hs_len;
+    int iter;
+
+    srand(1);
+    for (iter = 0; iter < 200; iter++) {
+        for (ne_len = 0; ne_len <= 24; ne_len++) {
+            size_t i;
+
+            /* Small alphabet to create many partial matches */
+            for (i = 0; i < ne_len; i++)
+                ne[i] = alpha[rand() % 4];
+            ne[ne_len] = '\0';
+            hs_len = rand() % (HS_LEN + 1);
+            for (i = 0; i < hs_len; i++)
+                hs[i] = alpha[rand() % 4];
+            hs[hs_len] = '\0';
+            check_one(hs, ne);
+
+            /* Plant the needle at each offset */
+            for (pos = 0; pos + ne_len <= hs_len; pos += 7) {
+                memcpy(hs + pos, ne, ne_len);
+                check_one(hs, ne);
+            }
+        }
+    }
+
+    /* Long haystacks are searched in chunks; straddle the boundaries */
+    static char long_hs[LONG_LEN + 1];
+    memset(long_hs, 'a', LONG_LEN);
+    long_hs[LONG_LEN] = '\0';
+    for (ne_len = 2; ne_len <= 20; ne_len += 3) {
+        memset(ne, 'a', ne_len - 1);
+        ne[ne_len - 1] = 'b';
+        ne[ne_len] = '\0';
+        for (pos = 500; pos + ne_len <= LONG_LEN; pos += 511) {
+            long_hs[pos + ne_len - 1] = 'b';
+            if (strstr(long_hs, ne) != long_hs + pos ||
+                strcasestr(long_hs, ne) != long_hs + pos ||
+                memmem(long_hs, LONG_LEN, ne, ne_len) != long_hs + pos)
+            {
+                printf("long haystack ne_len %zu pos %zu\n", ne_len, pos);
+                ret++;
+            }
+            long_hs[pos + ne_len - 1] = 'a';
+        }
+    }
+    return ret;
+}
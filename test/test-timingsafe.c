@@ -0,0 +1,161 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _DEFAULT_SOURCE
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench-timer.h"
+
+/*
+ * Check timingsafe_bcmp and timingsafe_memcmp results against memcmp,
+ * then time them with the difference at various positions. The timing
+ * takes the fastest of many runs for each position and prints them.
+ * Emulators and busy machines make the numbers noisy, so it only fails
+ * when they differ by more than TIMING_SLACK times; an implementation
+ * which stopped at the first difference would be faster by orders of
+ * magnitude for an early difference. Without a cycle counter the
+ * timing can't show anything, so the test is skipped after checking
+ * the results.
+ */
+
+#define TIMING_LEN      4096
+#define TIMING_RUNS     101
+
+/* Permitted ratio between slowest and fastest case */
+#define TIMING_SLACK    64
+
+static unsigned char a[TIMING_LEN + 16], b[TIMING_LEN + 16];
+static volatile int sink;
+static int ret;
+
+static int
+sign(int x)
+{
+    return (x > 0) - (x < 0);
+}
+
+static void
+check_results(void)
+{
+    size_t off, len, pos;
+
+    for (off = 0; off < 8; off++) {
+        for (len = 0; len < 72; len++) {
+            for (pos = 0; pos <= len; pos++) {
+                unsigned char *p = a + off, *q = b + 8 - off % 4;
+                size_t i;
+
+                for (i = 0; i < len; i++)
+                    p[i] = q[i] = (unsigned char) (i * 37 + len);
+                if (pos < len)
+                    q[pos] ^= (pos & 1) ? 0x80 : 0x01;
+
+                int expect = sign(memcmp(p, q, len));
+                if (timingsafe_bcmp(p, q, len) != (expect != 0) ||
+                    sign(timingsafe_memcmp(p, q, len)) != expect ||
+                    sign(timingsafe_memcmp(q, p, len)) != -expect)
+                {
+                    printf("wrong result off %zu len %zu pos %zu\n", off, len, pos);
+                    ret = 1;
+                }
+            }
+        }
+    }
+}
+
+#ifndef BENCH_COARSE
+static bench_t
+time_one(int memcmp_variant, size_t pos)
+{
+    bench_t best = ~(bench_t) 0;
+    int run;
+
+    memset(a, 0x55, TIMING_LEN);
+    memset(b, 0x55, TIMING_LEN);
+    if (pos < TIMING_LEN)
+        b[pos] = 0xaa;
+    for (run = 0; run < TIMING_RUNS; run++) {
+        bench_t t = bench_now();
+        if (memcmp_variant)
+            sink = timingsafe_memcmp(a, b, TIMING_LEN);
+        else
+            sink = timingsafe_bcmp(a, b, TIMING_LEN);
+        t = bench_now() - t;
+        if (t < best)
+            best = t;
+    }
+    return best;
+}
+
+static void
+check_timing(int memcmp_variant)
+{
+    static const size_t positions[] = { 0, 1, TIMING_LEN / 2, TIMING_LEN - 1, TIMING_LEN };
+    const char *name = memcmp_variant ? "timingsafe_memcmp" : "timingsafe_bcmp";
+    bench_t t, lo = ~(bench_t) 0, hi = 0;
+    unsigned i;
+
+    for (i = 0; i < sizeof(positions) / sizeof(positions[0]); i++) {
+        t = time_one(memcmp_variant, positions[i]);
+        if (t < lo)
+            lo = t;
+        if (t > hi)
+            hi = t;
+    }
+    printf("%s: %llu to %llu %ss\n", name, lo, hi, BENCH_UNIT);
+    if (hi > lo * TIMING_SLACK + 16) {
+        printf("%s: time depends on data\n", name);
+        ret = 1;
+    }
+}
+#endif
+
+int
+main(void)
+{
+    check_results();
+#ifdef BENCH_COARSE
+    if (ret == 0) {
+        printf("no cycle counter, skipping timing\n");
+        return 77;
+    }
+#else
+    check_timing(0);
+    check_timing(1);
+#endif
+    return ret;
+}
@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Copyright © 2026 Keith Packard
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ *    copyright notice, this list of conditions and the following
+ *    disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+ * INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * localtime_r and mktime across several years and TZ changes,
+ * including the cases which invalidate the tz-cache snapshot:
+ * rewriting TZ in place, switching TZ with tzset in between,
+ * unsetting it and converting years outside the cached range.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static int errors;
+
+#define check(cond, ...) do {                   \
+        if (!(cond)) {                          \
+            printf(__VA_ARGS__);                \
+            printf(": %s\n", #cond);            \
+            errors++;                           \
+        }                                       \
+    } while (0)
+
+static time_t
+utc(int year, int mon, int mday, int hour, int min, int sec)
+{
+    struct tm tm = {
+        .tm_year = year - 1900,
+        .tm_mon = mon - 1,
+        .tm_mday = mday,
+        .tm_hour = hour,
+        .tm_min = min,
+        .tm_sec = sec,
+    };
+
+    return timegm(&tm);
+}
+
+static void
+check_local(time_t t, int hour, int isdst, const char *what)
+{
+    struct tm tm;
+
+    localtime_r(&t, &tm);
+    check(tm.tm_hour == hour && tm.tm_isdst == isdst,
+          "%s: %lld got hour %d isdst %d want %d %d", what, (long long) t,
+          tm.tm_hour, tm.tm_isdst, hour, isdst);
+}
+
+static void
+check_mktime(int year, int mon, int mday, int hour, time_t want, const char *what)
+{
+    struct tm tm = {
+        .tm_year = year - 1900,
+        .tm_mon = mon - 1,
+        .tm_mday = mday,
+        .tm_hour = hour,
+        .tm_isdst = -1,
+    };
+    time_t t = mktime(&tm);
+
+    check(t == want, "%s: mktime %d-%d-%d %d got %lld want %lld", what,
+          year, mon, mday, hour, (long long) t, (long long) want);
+}
+
+static void
+check_zone(int std, int dst, int south, const char *what)
+{
+    int year;
+    int winter = south ? 7 : 1, summer = south ? 1 : 7;
+
+    /* Walk forwards and then backwards through the years */
+    for (year = 1990; year <= 2040; year++) {
+        check_local(utc(year, winter, 1, 12, 0, 0), (24 + 12 + std) % 24, 0, what);
+        check_local(utc(year, summer, 1, 12, 0, 0), (24 + 12 + dst) % 24, 1, what);
+    }
+    for (year = 2040; year >= 1990; year--) {
+        check_mktime(year, winter, 1, 6, utc(year, winter, 1, 6 - std, 0, 0), what);
+        check_mktime(year, summer, 1, 6, utc(year, summer, 1, 6 - dst, 0, 0), what);
+    }
+}
+
+int
+main(void)
+{
+    setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", 1);
+    check_zone(-5, -4, 0, "EST5EDT");
+
+    /* The 2024 transitions, to the second */
+    check_local(utc(2024, 3, 10, 6, 59, 59), 1, 0, "EST5EDT start");
+    check_local(utc(2024, 3, 10, 7, 0, 0), 3, 1, "EST5EDT start");
+    check_local(utc(2024, 11, 3, 5, 59, 59), 1, 1, "EST5EDT end");
+    check_local(utc(2024, 11, 3, 6, 0, 0), 1, 0, "EST5EDT end");
+
+    /* Southern hemisphere rules */
+    setenv("TZ", "AEST-10AEDT,M10.1.0,M4.1.0/3", 1);
+    check_zone(10, 11, 1, "AEST");
+
+    /* A value of the same length overwrites the old one in place */
+    setenv("TZ", "AAA5BBB,M3.2.0,M11.1.0", 1);
+    check_local(utc(2024, 1, 1, 12, 0, 0), 7, 0, "AAA5BBB");
+    setenv("TZ", "AAA6BBB,M3.2.0,M11.1.0", 1);
+    check_local(utc(2024, 1, 1, 12, 0, 0), 6, 0, "AAA6BBB");
+
+    /* tzset with a different TZ in between must not leave stale names */
+    setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1);
+    check_local(utc(2024, 7, 1, 12, 0, 0), 14, 1, "CET");
+    setenv("TZ", "JST-9", 1);
+    tzset();
+    check(strcmp(tzname[0], "JST") == 0, "tzname %s", tzname[0]);
+    setenv("TZ", "CET-1CEST,M3.5.0,M10.5.0/3", 1);
+    check_local(utc(2024, 7, 1, 12, 0, 0), 14, 1, "CET again");
+    check(strcmp(tzname[0], "CET") == 0 && strcmp(tzname[1], "CEST") == 0,
+          "tzname %s %s", tzname[0], tzname[1]);
+    check(_timezone == -3600 && _daylight, "timezone %ld daylight %d",
+          (long) _timezone, _daylight);
+
+    /* No TZ means UTC */
+    unsetenv("TZ");
+    check_local(utc(2024, 7, 1, 12, 0, 0), 12, 0, "unset");
+    check_mktime(2024, 7, 1, 12, utc(2024, 7, 1, 12, 0, 0), "unset");
+
+    return errors ? 1 : 0;
+}
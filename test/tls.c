@@ -170,6 +170,17 @@ hexdump(const void *ptr, int length, const char *hdr)
 	}
 }
 
+#ifdef _HAVE_PICOLIBC_TLS_API
+/* aligned_alloc wants the size to be a multiple of the alignment */
+static void *
+alloc_tls(void)
+{
+	size_t align = _tls_align();
+
+	return aligned_alloc(align, (_tls_size() + align - 1) & ~(align - 1));
+}
+#endif
+
 int
 main(void)
 {
@@ -221,6 +232,38 @@ main(void)
 	}
 
 	result += check_tls("allocated", true, tls);
+
+	if (_tls_align() < 128 || (_tls_align() & (_tls_align() - 1)) != 0) {
+		printf("TLS alignment %zu is wrong\n", _tls_align());
+		result++;
+	}
+
+	void *split = alloc_tls();
+	void *zeroed = alloc_tls();
+
+	if (!split || !zeroed) {
+		printf("TLS allocation failed\n");
+		result++;
+	} else {
+		/* Initialize the two parts separately, starting from garbage */
+		memset(split, 0xa5, _tls_size());
+		_init_tls_data(split);
+		_init_tls_bss(split);
+		_set_tls(split);
+		result += check_tls("split", true, split);
+
+		/* Start from zeroed memory, which needs no bss clear */
+		memset(zeroed, 0, _tls_size());
+		_init_tls_data(zeroed);
+		_set_tls(zeroed);
+		result += check_tls("zeroed", true, zeroed);
+	}
+
+	_setup_tls(tls);
+	result += check_tls("re-initialized", true, tls);
+
+	free(split);
+	free(zeroed);
 #endif
 
 	printf("tls test result %d\n", result);
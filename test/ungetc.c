@@ -51,5 +51,41 @@ main(void)
 		printf("getc unexpectedly returned %d instead of %d\n", ret, 'u');
 		return 1;
 	}
+#if defined(__PICOLIBC_UNGETC_DEPTH) && __PICOLIBC_UNGETC_DEPTH > 1
+	{
+		static char buf[] = "x";
+		FILE *f = fmemopen(buf, 1, "r");
+		int i;
+
+		if (!f) {
+			printf("fmemopen failed\n");
+			return 1;
+		}
+		for (i = 0; i < __PICOLIBC_UNGETC_DEPTH; i++) {
+			ret = ungetc('a' + i % 26, f);
+			if (ret != 'a' + i % 26) {
+				printf("ungetc %d unexpectedly returned %d\n", i, ret);
+				return 1;
+			}
+		}
+		if (ungetc('z', f) != EOF) {
+			printf("ungetc beyond depth %d succeeded\n", __PICOLIBC_UNGETC_DEPTH);
+			return 1;
+		}
+		while (i-- > 0) {
+			ret = getc(f);
+			if (ret != 'a' + i % 26) {
+				printf("getc %d unexpectedly returned %d\n", i, ret);
+				return 1;
+			}
+		}
+		ret = getc(f);
+		if (ret != 'x') {
+			printf("getc after pushback returned %d instead of %d\n", ret, 'x');
+			return 1;
+		}
+		fclose(f);
+	}
+#endif
 	return 0;
 }